@@ -0,0 +1,177 @@
+// Fast stdin reader shared by the C++ solvers
+//
+// FastInput reads a file descriptor (stdin by default) without iostreams:
+//   - a regular file is mapped read-only and parsed in place, no copies;
+//   - anything else (pipe, terminal) is read in 1 MB chunks and parsed token
+//     by token, so a line is available as soon as it arrives and streaming
+//     modes keep answering readings one at a time.
+//
+// Extraction mirrors istream, including the sticky failure state:
+//
+//     FastInput in;
+//     int n; double x; string s; char c;
+//     if (!(in >> n >> x >> s >> c)) ...   // false once any read failed
+//
+// Tokens are separated by whitespace (any byte <= ' '). Integers take an
+// optional sign and decimal digits with no overflow check; doubles go through
+// std::from_chars; a char is the next non-whitespace byte. A token that is not
+// entirely a number fails the read. Solvers that parse the input themselves
+// (e.g. split across threads) call rest() for the unread part as one buffer.
+
+#pragma once
+
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+inline bool isInputSpace(char c) {
+    return (unsigned char)c <= ' ';
+}
+
+// Integer at p (after whitespace) in [p, end); advances p past it
+template <class T>
+inline bool parseInt(const char*& p, const char* end, T& v) {
+    while (p < end && isInputSpace(*p)) ++p;
+    const char* q = p;
+    bool negative = false;
+    if (q < end && (*q == '-' || *q == '+')) negative = *q++ == '-';
+    typename std::make_unsigned<T>::type x = 0;
+    const char* digits = q;
+    for (unsigned d; q < end && (d = (unsigned)(*q - '0')) < 10; ++q) x = x * 10 + d;
+    if (q == digits) return false;
+    v = (T)(negative ? 0 - x : x);
+    p = q;
+    return true;
+}
+
+// Double at p (after whitespace) in [p, end); advances p past it
+inline bool parseDouble(const char*& p, const char* end, double& v) {
+    while (p < end && isInputSpace(*p)) ++p;
+    const char* q = p;
+    if (q < end && *q == '+') ++q;   // from_chars rejects a leading '+'
+    auto [next, ec] = std::from_chars(q, end, v);
+    if (ec != std::errc()) return false;
+    p = next;
+    return true;
+}
+
+class FastInput {
+public:
+    explicit FastInput(int fd = STDIN_FILENO) : fd(fd) {
+        struct stat st;
+        off_t offset = lseek(fd, 0, SEEK_CUR);
+        if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && offset >= 0 && offset < st.st_size) {
+            void* p = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p != MAP_FAILED) {
+                madvise(p, st.st_size, MADV_SEQUENTIAL);
+                mapped = static_cast<const char*>(p);
+                mappedBytes = st.st_size;
+                cur = mapped + offset;
+                last = mapped + mappedBytes;
+                eof = true;
+                return;
+            }
+        }
+        buffer.resize(CHUNK);
+        cur = last = buffer.data();
+    }
+    FastInput(const FastInput&) = delete;
+    FastInput& operator=(const FastInput&) = delete;
+    ~FastInput() {
+        if (mapped) munmap(const_cast<char*>(mapped), mappedBytes);
+    }
+
+    explicit operator bool() const { return !failed; }
+
+    template <class T>
+    typename std::enable_if<std::is_integral<T>::value, FastInput&>::type operator>>(T& v) {
+        const char *b, *e;
+        if (!token(b, e) || !parseInt(b, e, v) || b != e) failed = true;
+        return *this;
+    }
+
+    FastInput& operator>>(double& v) {
+        const char *b, *e;
+        if (!token(b, e) || !parseDouble(b, e, v) || b != e) failed = true;
+        return *this;
+    }
+
+    FastInput& operator>>(std::string& s) {
+        const char *b, *e;
+        if (token(b, e)) s.assign(b, e);
+        else failed = true;
+        return *this;
+    }
+
+    FastInput& operator>>(char& c) {
+        if (failed || !skipSpace()) failed = true;
+        else c = *cur++;
+        return *this;
+    }
+
+    // Everything not read yet, loading the rest of a stream first; the view
+    // stays valid until the next read from this object
+    std::string_view rest() {
+        while (refill()) {}
+        return std::string_view(cur, last - cur);
+    }
+
+private:
+    static const size_t CHUNK = 1 << 20;
+
+    // Read more after [cur, last), moving it to the front; false at EOF
+    bool refill() {
+        if (eof) return false;
+        size_t keep = last - cur;
+        if (keep && cur != buffer.data()) memmove(buffer.data(), cur, keep);
+        if (buffer.size() - keep < CHUNK / 2) buffer.resize(buffer.size() * 2);
+        ssize_t r;
+        do {
+            r = read(fd, buffer.data() + keep, buffer.size() - keep);
+        } while (r < 0 && errno == EINTR);
+        cur = buffer.data();
+        last = cur + keep + (r > 0 ? r : 0);
+        if (r <= 0) eof = true;
+        return r > 0;
+    }
+
+    bool skipSpace() {
+        while (true) {
+            while (cur < last && isInputSpace(*cur)) ++cur;
+            if (cur < last) return true;
+            if (!refill()) return false;
+        }
+    }
+
+    // Next token as [b, e), complete even across chunk boundaries
+    bool token(const char*& b, const char*& e) {
+        if (failed || !skipSpace()) return false;
+        const char* p = cur;
+        while (true) {
+            while (p < last && !isInputSpace(*p)) ++p;
+            if (p < last || eof) break;
+            size_t scanned = p - cur;
+            refill();
+            p = cur + scanned;
+        }
+        b = cur;
+        e = cur = p;
+        return true;
+    }
+
+    int fd;
+    const char* mapped = nullptr;
+    size_t mappedBytes = 0;
+    std::vector<char> buffer;
+    const char* cur = nullptr;
+    const char* last = nullptr;
+    bool eof = false;
+    bool failed = false;
+};
@@ -0,0 +1,157 @@
+// Buffered stdout writer shared by the C++ solvers
+//
+// FastOutput collects everything in one contiguous buffer (1 MB by default)
+// and hands it to write(2) in a single call when the buffer fills, on flush()
+// and on destruction, so printing m lines costs about m / 50000 system calls
+// and no iostream formatting:
+//
+//     FastOutput out;
+//     out << count << ' ' << Fixed{ratio, 6} << '\n';
+//     if (interactive) out.flush();
+//
+// Integers are formatted two digits at a time from a 00..99 table. Fixed{v, p}
+// prints v with p digits after the point through std::to_chars, which gives
+// exactly the digits of printf("%.*f", p, v). formatUint, formatInt and
+// formatFixed write into caller-owned memory, e.g. per-thread strings. Don't mix FastOutput and cout
+// on the same stream without flushing one before writing to the other.
+
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include <unistd.h>
+
+// Write the decimal digits of v at p and return the end; p needs room for 20 chars
+inline char* formatUint(char* p, unsigned long long v) {
+    static const char pairs[] =
+        "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+        "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+        "8081828384858687888990919293949596979899";
+    char tmp[20];
+    char* t = tmp + sizeof(tmp);
+    while (v >= 100) {
+        t -= 2;
+        memcpy(t, pairs + 2 * (v % 100), 2);
+        v /= 100;
+    }
+    if (v >= 10) {
+        t -= 2;
+        memcpy(t, pairs + 2 * v, 2);
+    } else {
+        *--t = char('0' + v);
+    }
+    size_t len = tmp + sizeof(tmp) - t;
+    memcpy(p, t, len);
+    return p + len;
+}
+
+// formatUint with a leading '-' for negatives
+inline char* formatInt(char* p, long long v) {
+    if (v < 0) {
+        *p++ = '-';
+        return formatUint(p, 0 - (unsigned long long)v);
+    }
+    return formatUint(p, v);
+}
+
+// Largest output of formatFixed: 309 integer digits, sign and point
+inline size_t fixedBytes(int precision) {
+    return 311 + (size_t)std::max(0, precision);
+}
+
+// Write v with precision digits after the point, as printf("%.*f") would;
+// p needs room for fixedBytes(precision) chars
+inline char* formatFixed(char* p, double v, int precision) {
+    return std::to_chars(p, p + fixedBytes(precision), v, std::chars_format::fixed, precision).ptr;
+}
+
+// A double printed with a fixed number of digits after the point
+struct Fixed {
+    double value;
+    int precision;
+};
+
+class FastOutput {
+public:
+    explicit FastOutput(int fd = STDOUT_FILENO, size_t capacity = 1 << 20)
+        : fd(fd), buffer(std::max<size_t>(capacity, 4096)) {}
+    FastOutput(const FastOutput&) = delete;
+    FastOutput& operator=(const FastOutput&) = delete;
+    ~FastOutput() { flush(); }
+
+    FastOutput& operator<<(char c) {
+        if (len == buffer.size()) flush();
+        buffer[len++] = c;
+        return *this;
+    }
+
+    FastOutput& operator<<(std::string_view s) {
+        if (s.size() > buffer.size() - len) {
+            flush();
+            if (s.size() > buffer.size()) {
+                writeAll(s.data(), s.size());
+                return *this;
+            }
+        }
+        memcpy(buffer.data() + len, s.data(), s.size());
+        len += s.size();
+        return *this;
+    }
+
+    FastOutput& operator<<(const char* s) { return *this << std::string_view(s); }
+    FastOutput& operator<<(const std::string& s) { return *this << std::string_view(s); }
+
+    template <class T>
+    typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, char>::value
+                            && !std::is_same<T, bool>::value, FastOutput&>::type
+    operator<<(T v) {
+        char* p = room(20);
+        len = (std::is_signed<T>::value ? formatInt(p, (long long)v)
+                                        : formatUint(p, (unsigned long long)v)) - buffer.data();
+        return *this;
+    }
+
+    FastOutput& operator<<(Fixed f) {
+        size_t need = fixedBytes(f.precision);
+        if (need > buffer.size()) {
+            flush();
+            buffer.resize(need);
+        }
+        len = formatFixed(room(need), f.value, f.precision) - buffer.data();
+        return *this;
+    }
+
+    void flush() {
+        writeAll(buffer.data(), len);
+        len = 0;
+    }
+
+private:
+    // Pointer to at least n free bytes, flushing first if needed
+    char* room(size_t n) {
+        if (buffer.size() - len < n) flush();
+        return buffer.data() + len;
+    }
+
+    void writeAll(const char* p, size_t n) {
+        while (n > 0) {
+            ssize_t w = write(fd, p, n);
+            if (w < 0) {
+                if (errno == EINTR) continue;
+                return;   // closed pipe or full disk: drop the rest
+            }
+            p += w;
+            n -= w;
+        }
+    }
+
+    int fd;
+    std::vector<char> buffer;
+    size_t len = 0;
+};
@@ -1,5 +1,4 @@
 import sys
-sys.setrecursionlimit(1_000_000)
 
 from typing import Optional, Tuple, Iterator, Dict, List, Union
 
@@ -21,6 +20,16 @@ from typing import Optional, Tuple, Iterator, Dict, List, Union
 # Among all possible removal sequences, lexicographically max and min can be obtained greedily by
 # trying candidates (s, Prev) in descending or ascending s order respectively, always verifying
 # that the remaining tree can still be undone. We memoize the results by a structural digest.
+#
+# Digests are hash-consed: every distinct (val, left digest, right digest) triple gets a small
+# integer ID from NODE_TABLE, and equal subtrees share one canonical Node. Digest computation,
+# memo lookups and building an undo candidate are therefore O(1) per node instead of hashing
+# and comparing nested tuples of subtree size.
+#
+# Nothing recurses. Every undo candidate of a tree comes from one node d on its left spine (case 1
+# there, then case 2 at each ancestor), and since values grow down the spine, descending s is
+# deepest-first and ascending s is shallowest-first. The spine is collected into a reusable
+# buffer once per tree, and the greedy search keeps its own stack of (tree, spine, next depth).
 
 class Node:
     __slots__ = ('val', 'left', 'right', 'digest')
@@ -28,17 +37,64 @@ class Node:
         self.val = val
         self.left = left
         self.right = right
-        self.digest: Optional[Tuple[int, Optional[Tuple], Optional[Tuple]]] = None
-
-
-def compute_digest(node: Optional[Node]) -> Optional[Tuple[int, Optional[Tuple], Optional[Tuple]]]:
+        self.digest: Optional[int] = None
+
+
+class NodeTable:
+    """Hash-consing table: one canonical Node and integer ID per (val, left ID, right ID).
+    ID 0 is the empty tree."""
+    __slots__ = ('ids', 'nodes')
+
+    def __init__(self):
+        self.ids: Dict[Tuple[int, int, int], Node] = {}
+        self.nodes: List[Optional[Node]] = [None]
+
+    def intern(self, node: Node) -> Node:
+        """Give node (whose children are already interned) its ID, or return the existing
+        canonical node with the same structure."""
+        key = (node.val,
+               node.left.digest if node.left is not None else 0,
+               node.right.digest if node.right is not None else 0)
+        canon = self.ids.get(key)
+        if canon is None:
+            node.digest = len(self.nodes)
+            self.nodes.append(node)
+            self.ids[key] = node
+            canon = node
+        return canon
+
+    def make(self, val: int, left: Optional[Node], right: Optional[Node]) -> Node:
+        """Canonical node for (val, left, right); allocates only if the triple is new."""
+        key = (val,
+               left.digest if left is not None else 0,
+               right.digest if right is not None else 0)
+        canon = self.ids.get(key)
+        if canon is None:
+            canon = Node(val, left, right)
+            canon.digest = len(self.nodes)
+            self.nodes.append(canon)
+            self.ids[key] = canon
+        return canon
+
+
+NODE_TABLE = NodeTable()
+
+
+def compute_digest(node: Optional[Node]) -> int:
     if node is None:
-        return None
-    if node.digest is not None:
-        return node.digest
-    ld = compute_digest(node.left)
-    rd = compute_digest(node.right)
-    node.digest = (node.val, ld, rd)
+        return 0
+    # Post-order without recursion: intern a node once both children have IDs
+    stack = [node]
+    while stack:
+        top = stack[-1]
+        if top.left is not None and top.left.digest is None:
+            stack.append(top.left)
+        elif top.right is not None and top.right.digest is None:
+            stack.append(top.right)
+        else:
+            stack.pop()
+            if top.digest is None:
+                NODE_TABLE.intern(top)
     return node.digest
 
 
@@ -146,18 +202,55 @@ def heap_ok_at_root(node: Node) -> bool:
 
 
 def make_prev_node(root_val: int, left: Optional[Node], right: Optional[Node]) -> Optional[Node]:
-    prev = Node(root_val, left=left, right=right)
-    # Structural and heap checks at root (quick prune)
-    if not structural_ok_at_root(prev):
+    # Structural and heap checks at root (quick prune) before anything is allocated
+    if left is None and right is not None:
         return None
-    # The left child is 'left', right is 'right' as per construction
-    if left is not None and prev.val > left.val:
+    if left is not None and root_val > left.val:
         return None
-    if right is not None and prev.val > right.val:
+    if right is not None and root_val > right.val:
         return None
-    # Compute digest
-    compute_digest(prev)
-    return prev
+    # Children are canonical, so this is a single table lookup
+    return NODE_TABLE.make(root_val, left, right)
+
+
+def load_spine(node: Node, spine: List[Node]) -> List[Node]:
+    """
+    Fill spine with node, node.left, node.left.left, ... (reusing the list), stopping at the
+    deepest entry that can yield an undo. Climbing past spine[i] with a non-empty undone subtree
+    makes it Prev's right child, so spine[i].right must exist to become Prev's left (structural
+    rule), for every i <= d - 2: depth d is useless beyond the first node without a right child
+    plus one.
+    """
+    spine.clear()
+    while node is not None:
+        spine.append(node)
+        if node.right is None:
+            if node.left is not None:
+                spine.append(node.left)
+            break
+        node = node.left
+    return spine
+
+
+def undo_at_depth(spine: List[Node], d: int) -> Tuple[bool, Optional[Node]]:
+    """
+    The one-step undo removing spine[d]'s value: case 1 at spine[d], then case 2 at each ancestor
+    on the way back up. Returns (True, Prev) or (False, None) if some step is not allowed.
+    """
+    nd = spine[d]
+    if nd.right is not None or (nd.left is not None and nd.val > nd.left.val):
+        return False, None
+    s = nd.val
+    prev = nd.left
+    for i in range(d - 1, -1, -1):
+        ni = spine[i]
+        if s < ni.val:
+            return False, None
+        # Prev for spine[i]: left = its right subtree, right = the undone left subtree
+        prev = make_prev_node(ni.val, ni.right, prev)
+        if prev is None:
+            return False, None
+    return True, prev
 
 
 def iter_one_step_undos(node: Node, order: str) -> Iterator[Tuple[int, Optional[Node]]]:
@@ -165,120 +258,165 @@ def iter_one_step_undos(node: Node, order: str) -> Iterator[Tuple[int, Optional[
     Yield (s, Prev) pairs for undoing one insertion from 'node'.
     Order: 'desc' yields candidates in descending s; 'asc' yields in ascending s.
     """
-    # Helper to generate left-derived (case 2) candidates in a given order
-    def gen_left_first_desc(n: Node) -> Iterator[Tuple[int, Optional[Node]]]:
-        # Left-derived candidates first (descending by s)
-        if n.left is not None:
-            for s_left, B in iter_one_step_undos(n.left, 'desc'):
-                # Case 2 condition: s_left >= n.val
-                if s_left < n.val:
-                    # Since descending, all further s will be <= current, so can break early
-                    break
-                # Build Prev for this node: Prev.left = n.right, Prev.right = B
-                prev_node = make_prev_node(n.val, left=n.right, right=B)
-                if prev_node is None:
+    spine = load_spine(node, [])
+    depths = range(len(spine) - 1, -1, -1) if order == 'desc' else range(len(spine))
+    for d in depths:
+        ok, prev = undo_at_depth(spine, d)
+        if ok:
+            yield (spine[d].val, prev)
+
+
+# Caches for lexicographic removal sequences, keyed by node ID. Each entry is the greedy first
+# step (s, Prev) whose remainder is producible, or None if the tree is not producible; the full
+# sequence is read off by following the steps, so no per-node tuple is ever copied.
+LexStep = Optional[Tuple[int, Optional[Node]]]
+lex_cache_desc: Dict[int, LexStep] = {}
+lex_cache_asc: Dict[int, LexStep] = {}
+
+# Spine buffer of the explicit search, shared by all levels and kept across calls
+_spine: List[Node] = []
+
+
+def lex_step(node: Node, order: str) -> LexStep:
+    """
+    First step of the lexicographically extreme removal sequence of a non-empty node.
+
+    Depth-first search with an explicit stack: each level holds a tree and the next spine depth
+    to try. The first candidate whose Prev is empty or known producible settles its level and,
+    with it, every level below on the stack; a level that runs out of candidates is cached as
+    not producible and the level below tries its next candidate. Only the top level's spine is
+    loaded at a time, so memory stays O(stack depth + spine).
+    """
+    desc = order == 'desc'
+    cache = lex_cache_desc if desc else lex_cache_asc
+    if node.digest in cache:
+        return cache[node.digest]
+
+    trees: List[Node] = []
+    nexts: List[int] = []      # next spine depth to try
+    chosen: List[int] = []     # s of the candidate being explored
+    spine = _spine
+    loaded = -1                # stack level whose spine is in the buffer
+
+    def push(tree: Node) -> bool:
+        # Quick local invalidity checks (shouldn't occur for valid states, but prune aggressively)
+        if not structural_ok_at_root(tree) or not heap_ok_at_root(tree):
+            cache[tree.digest] = None
+            return False
+        load_spine(tree, spine)
+        trees.append(tree)
+        nexts.append(len(spine) - 1 if desc else 0)
+        chosen.append(0)
+        return True
+
+    if not push(node):
+        return None
+    loaded = 0
+    step = -1 if desc else 1
+    while trees:
+        level = len(trees) - 1
+        if loaded != level:
+            load_spine(trees[level], spine)
+            loaded = level
+        d = nexts[level]
+        if d < 0 or d >= len(spine):
+            # Out of candidates
+            cache[trees.pop().digest] = None
+            nexts.pop()
+            chosen.pop()
+            continue
+        nexts[level] = d + step
+
+        ok, prev = undo_at_depth(spine, d)
+        if not ok:
+            continue
+        s = spine[d].val
+        if prev is not None:
+            known = cache.get(prev.digest, False)
+            if known is False:
+                # Unknown: explore it first, this level resumes afterwards
+                chosen[level] = s
+                if push(prev):
+                    loaded = level + 1
                     continue
-                yield (s_left, prev_node)
-        # Root-derived candidate (case 1) last
-        if n.right is None and (n.left is None or n.val < n.left.val):
-            # Prev is the left subtree itself
-            yield (n.val, n.left)
-
-    def gen_root_first_asc(n: Node) -> Iterator[Tuple[int, Optional[Node]]]:
-        # Root-derived candidate first (ascending by s)
-        if n.right is None and (n.left is None or n.val < n.left.val):
-            yield (n.val, n.left)
-        # Then left-derived candidates (ascending by s)
-        if n.left is not None:
-            for s_left, B in iter_one_step_undos(n.left, 'asc'):
-                if s_left >= n.val:
-                    prev_node = make_prev_node(n.val, left=n.right, right=B)
-                    if prev_node is None:
-                        continue
-                    yield (s_left, prev_node)
-                # If s_left < n.val, skip; later s_left may be >= n.val since ascending
-
-    if order == 'desc':
-        yield from gen_left_first_desc(node)
-    else:
-        yield from gen_root_first_asc(node)
-
-
-# Caches for lexicographic removal sequences
-LexSeq = Optional[Tuple[int, ...]]
-lex_cache_desc: Dict[Optional[Tuple], LexSeq] = {}
-lex_cache_asc: Dict[Optional[Tuple], LexSeq] = {}
-
-
-def lex_removal(node: Optional[Node], order: str) -> LexSeq:
+                load_spine(trees[level], spine)
+                known = None
+            if known is None:
+                continue
+
+        # Producible: settle this level and all the pending ones below it
+        cache[trees[level].digest] = (s, prev)
+        for lvl in range(level - 1, -1, -1):
+            cache[trees[lvl].digest] = (chosen[lvl], trees[lvl + 1])
+        break
+
+    return cache[node.digest]
+
+
+def lex_removal(node: Optional[Node], order: str) -> Optional[Tuple[int, ...]]:
     """
     Return the lexicographically extreme removal sequence for the given node:
     - order == 'desc': lexicographically maximal removal sequence
     - order == 'asc': lexicographically minimal removal sequence
     Returns None if the tree is not producible.
     """
-    if node is None:
-        return tuple()
-    digest = node.digest
-    cache = lex_cache_desc if order == 'desc' else lex_cache_asc
-    if digest in cache:
-        return cache[digest]
-
-    # Quick local invalidity checks (shouldn't occur for valid states, but prune aggressively)
-    if not structural_ok_at_root(node) or not heap_ok_at_root(node):
-        cache[digest] = None
-        return None
-
-    for s, prev in iter_one_step_undos(node, order):
-        seq_rest = lex_removal(prev, order)
-        if seq_rest is not None:
-            res = (s,) + seq_rest
-            cache[digest] = res
-            return res
+    seq: List[int] = []
+    while node is not None:
+        step = lex_step(node, order)
+        if step is None:
+            return None
+        s, node = step
+        seq.append(s)
+    return tuple(seq)
 
-    cache[digest] = None
-    return None
-
-
-def main():
-    try:
-        n, L, R = parse_input()
-    except ValueError:
-        print("impossible")
-        return
 
+def solve(n: int, L: List[int], R: List[int]) -> Optional[Tuple[List[int], List[int]]]:
+    """
+    Lexicographically smallest and largest insertion sequences producing the tree with children
+    L[i], R[i] (1-based, 0 = none), or None if no sequence produces it. NODE_TABLE and the lex
+    caches stay filled between calls, so subtrees shared with earlier inputs are not re-solved.
+    """
     if n == 0:
         # No nodes; specification implies n >= 1 normally, but handle gracefully.
-        print("impossible")
-        return
+        return None
 
     root_idx = find_root_and_validate(n, L, R)
     if root_idx is None:
-        print("impossible")
-        return
+        return None
 
     if not initial_properties_valid(n, L, R):
-        print("impossible")
-        return
+        return None
 
     root = build_nodes(n, L, R, root_idx)
 
     # Compute lexicographically extreme removal sequences
     desc_rem = lex_removal(root, 'desc')
     if desc_rem is None:
-        print("impossible")
-        return
+        return None
     asc_rem = lex_removal(root, 'asc')
     if asc_rem is None:
-        print("impossible")
-        return
+        return None
 
     # Convert to insertion sequences by reversing the removal sequences.
     # Following the provided guideline: min insertion = reverse(max removal), max insertion = reverse(min removal).
     ins_min = list(reversed(desc_rem))
     ins_max = list(reversed(asc_rem))
+    return ins_min, ins_max
+
+
+def main():
+    try:
+        n, L, R = parse_input()
+    except ValueError:
+        print("impossible")
+        return
+
+    result = solve(n, L, R)
+    if result is None:
+        print("impossible")
+        return
 
-    # Output
+    ins_min, ins_max = result
     print(" ".join(map(str, ins_min)))
     print(" ".join(map(str, ins_max)))
 
@@ -0,0 +1,175 @@
+#!/usr/bin/env python3
+"""
+Blackboard Game - precomputed answer table
+
+Usage: python3 answer_table.py --max-n=N --out=PATH
+Then:  python3 solution.py --table=PATH < input.txt
+
+Computes the exact answer (winner and smallest winning first move) for every n <= N in one
+incremental pass and writes it as a binary table; load_table() maps it back for direct lookup.
+
+The game is undirected vertex geography on the graph joining x and x * p (p prime): after the
+first player writes s, the second player moves from s, and the player to move from a vertex
+wins iff every maximum matching covers it. So s wins for the first player iff some maximum
+matching leaves s uncovered. The graph is bipartite (each move changes the number of prime
+factors by one), so plain alternating paths suffice:
+- numbers are added in increasing order, each joined to n / p for its prime factors p, taken
+  from a smallest-prime-factor sieve, and the matching is grown by at most one augmenting
+  path from the new number;
+- s is uncovered by some maximum matching iff it is free, or an even alternating path
+  s - mate(s) - x' - mate(x') - ... reaches a free number; a failed search marks everything it
+  visited as covered for this n, so each n costs at most one full alternating search.
+retrograde.py --table=PATH checks the table against exhaustive game search.
+
+Table format (little-endian): b"BBGT", uint32 version, uint32 N, then uint32 answer[0..N],
+where answer[n] is 0 for "second" and the first move otherwise.
+"""
+
+import sys
+import time
+from array import array
+
+TABLE_MAGIC = b"BBGT"
+TABLE_VERSION = 1
+
+
+def build_answers(max_n):
+    """answer[n] for n in 0..max_n: 0 if the second player wins, else the smallest winning start."""
+    spf = list(range(max_n + 1))
+    for i in range(2, int(max_n ** 0.5) + 1):
+        if spf[i] == i:
+            for j in range(i * i, max_n + 1, i):
+                if spf[j] == j:
+                    spf[j] = i
+
+    adj = [[] for _ in range(max_n + 1)]
+    mate = [-1] * (max_n + 1)
+    parent = [0] * (max_n + 1)
+    seen = [0] * (max_n + 1)      # search stamp
+    covered = [0] * (max_n + 1)   # n for which the number is known to be in every max matching
+    stamp = 0
+    answer = array('I', bytes(4 * (max_n + 1)))
+
+    for n in range(2, max_n + 1):
+        # Sieve step: join n to n / p for each distinct prime factor p
+        x = n
+        while x > 1:
+            p = spf[x]
+            adj[n].append(n // p)
+            adj[n // p].append(n)
+            while x % p == 0:
+                x //= p
+
+        # Any augmenting path now has to start at the new (free) number n
+        stamp += 1
+        seen[n] = stamp
+        queue = [n]
+        found = -1
+        for u in queue:
+            for y in adj[u]:
+                if seen[y] == stamp:
+                    continue
+                seen[y] = stamp
+                parent[y] = u
+                if mate[y] == -1:
+                    found = y
+                    break
+                z = mate[y]
+                seen[z] = stamp
+                queue.append(z)
+            if found != -1:
+                break
+        y = found
+        while y != -1:
+            u = parent[y]
+            nxt = mate[u]        # -1 once u is n
+            mate[u] = y
+            mate[y] = u
+            y = nxt
+
+        # Smallest even s left uncovered by some maximum matching
+        for s in range(2, n + 1, 2):
+            if mate[s] == -1:
+                answer[n] = s
+                break
+            if covered[s] == n:
+                continue
+            stamp += 1
+            seen[s] = stamp
+            queue = [s]
+            free = False
+            for u in queue:
+                for v in adj[mate[u]]:
+                    if v == u or seen[v] == stamp:
+                        continue
+                    if mate[v] == -1:
+                        free = True
+                        break
+                    seen[v] = stamp
+                    queue.append(v)
+                if free:
+                    break
+            if free:
+                answer[n] = s
+                break
+            # Everything reached from s only reaches what s reaches
+            for u in queue:
+                covered[u] = n
+
+    return answer
+
+
+def write_table(path, answer):
+    header = array('I', [TABLE_VERSION, len(answer) - 1])
+    body = array('I', answer)
+    if sys.byteorder == 'big':
+        header.byteswap()
+        body.byteswap()
+    with open(path, 'wb') as f:
+        f.write(TABLE_MAGIC)
+        f.write(header.tobytes())
+        f.write(body.tobytes())
+
+
+def load_table(path):
+    """The answer array written by write_table (answer[n] for n in 0..N)."""
+    with open(path, 'rb') as f:
+        data = f.read()
+    if data[:4] != TABLE_MAGIC:
+        raise ValueError(f"{path}: not a Blackboard Game table")
+    header = array('I', data[4:12])
+    if sys.byteorder == 'big':
+        header.byteswap()
+    version, max_n = header
+    if version != TABLE_VERSION or len(data) != 12 + 4 * (max_n + 1):
+        raise ValueError(f"{path}: unsupported version or truncated table")
+    answer = array('I', data[12:])
+    if sys.byteorder == 'big':
+        answer.byteswap()
+    return answer
+
+
+def main():
+    max_n, out = None, None
+    for arg in sys.argv[1:]:
+        if arg.startswith("--max-n="):
+            max_n = int(arg[8:])
+        elif arg.startswith("--out="):
+            out = arg[6:]
+        else:
+            max_n = None
+            break
+    if max_n is None or max_n < 1 or out is None:
+        print("Usage: python3 answer_table.py --max-n=N --out=PATH", file=sys.stderr)
+        sys.exit(1)
+
+    t0 = time.time()
+    answer = build_answers(max_n)
+    write_table(out, answer)
+    second = sum(1 for n in range(1, max_n + 1) if answer[n] == 0)
+    print(f"n <= {max_n}: {second} second-player wins, {time.time() - t0:.2f}s, "
+          f"{12 + 4 * (max_n + 1)} bytes -> {out}", file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
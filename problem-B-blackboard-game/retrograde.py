@@ -0,0 +1,194 @@
+#!/usr/bin/env python3
+"""
+Blackboard Game - exact solver used to validate the O(1) pattern
+
+Usage: python3 retrograde.py [--from=N] [--to=N] [--jobs=J] [--table=PATH]
+
+For every n in [from, to] (default 2..40) this solves the game exactly, for every even
+starting number, and checks the answer of solution.solve(n), or of an answer_table.py table:
+the winner must agree, and a "first" answer's move must be one of the winning starts. Prints
+one line per n and exits with status 1 if any n disagrees.
+
+Engine:
+- PrimeGraph holds a smallest-prime-factor sieve and, for every number, its prime
+  neighbours (x * p and x / p) as one integer bitmask, so move generation is bit operations.
+- A position is the current number plus the set of unwritten numbers still reachable from it
+  through unwritten numbers; everything else can never be played again, so dropping it keeps
+  the analysis exact while merging many positions. It is encoded as one int,
+  (free_mask << shift) | current.
+- Results are memoised by that int; starting numbers are spread over J worker processes,
+  each with its own table, and the per-start results land in a flat bytearray.
+"""
+
+import sys
+import time
+from multiprocessing import Pool
+
+from solution import solve
+
+
+class PrimeGraph:
+    """Numbers 1..n with an edge between x and x * p for every prime p."""
+
+    def __init__(self, n):
+        self.n = n
+        spf = list(range(n + 1))
+        for i in range(2, int(n ** 0.5) + 1):
+            if spf[i] == i:
+                for j in range(i * i, n + 1, i):
+                    if spf[j] == j:
+                        spf[j] = i
+        self.spf = spf
+        primes = [p for p in range(2, n + 1) if spf[p] == p]
+        adj = [0] * (n + 1)
+        for x in range(1, n + 1):
+            for p in primes:
+                y = x * p
+                if y > n:
+                    break
+                adj[x] |= 1 << y
+                adj[y] |= 1 << x
+        self.adj = adj
+        self.all = ((1 << (n + 1)) - 1) ^ 1     # numbers 1..n
+        self.shift = n.bit_length()
+
+    def reachable(self, cur, free):
+        """Numbers in free reachable from cur through numbers in free."""
+        adj = self.adj
+        seen = 1 << cur
+        frontier = seen
+        while frontier:
+            nxt = 0
+            while frontier:
+                b = frontier & -frontier
+                frontier ^= b
+                nxt |= adj[b.bit_length() - 1]
+            frontier = nxt & free & ~seen
+            seen |= frontier
+        return seen & free
+
+
+class Solver:
+    """Win/loss of positions of one board, memoised by compact integer state."""
+
+    def __init__(self, graph):
+        self.graph = graph
+        self.table = {}
+
+    def mover_wins(self, cur, free):
+        """True if the player to move from cur wins; free = unwritten numbers reachable."""
+        key = (free << self.graph.shift) | cur
+        result = self.table.get(key)
+        if result is not None:
+            return result
+
+        adj = self.graph.adj
+        moves = adj[cur] & free
+        # A neighbour with no unwritten neighbour of its own leaves the opponent stuck
+        m = moves
+        while m:
+            b = m & -m
+            m ^= b
+            if not adj[b.bit_length() - 1] & (free ^ b):
+                self.table[key] = True
+                return True
+
+        result = False
+        m = moves
+        while m:
+            b = m & -m
+            m ^= b
+            v = b.bit_length() - 1
+            if not self.mover_wins(v, self.graph.reachable(v, free ^ b)):
+                result = True
+                break
+        self.table[key] = result
+        return result
+
+    def start_wins(self, s):
+        """True if writing s first wins (the opponent moves from s and loses)."""
+        g = self.graph
+        return not self.mover_wins(s, g.reachable(s, g.all & ~(1 << s)))
+
+
+_worker = None
+
+
+def _solve_starts(args):
+    """Worker: results for a slice of starting numbers of one n."""
+    global _worker
+    n, starts = args
+    if _worker is None or _worker.graph.n != n:
+        _worker = Solver(PrimeGraph(n))
+    return [(s, _worker.start_wins(s)) for s in starts]
+
+
+def exact_starts(n, pool, jobs):
+    """Flat bytearray: result[s] = 1 if even start s wins for the first player."""
+    result = bytearray(n + 1)
+    starts = list(range(2, n + 1, 2))
+    if not starts:
+        return result
+    chunks = [(n, starts[i::jobs]) for i in range(jobs) if starts[i::jobs]]
+    parts = pool.map(_solve_starts, chunks) if pool else [_solve_starts(c) for c in chunks]
+    for part in parts:
+        for s, wins in part:
+            result[s] = wins
+    return result
+
+
+def main():
+    lo, hi, jobs = 2, 40, 1
+    table = None
+    for arg in sys.argv[1:]:
+        if arg.startswith("--from="):
+            lo = int(arg[7:])
+        elif arg.startswith("--to="):
+            hi = int(arg[5:])
+        elif arg.startswith("--jobs="):
+            jobs = max(1, int(arg[7:]))
+        elif arg.startswith("--table="):
+            from answer_table import load_table
+            table = load_table(arg[8:])
+        else:
+            print("Usage: python3 retrograde.py [--from=N] [--to=N] [--jobs=J] [--table=PATH]",
+                  file=sys.stderr)
+            sys.exit(1)
+
+    mismatches = 0
+    pool = Pool(jobs) if jobs > 1 else None
+    try:
+        for n in range(max(lo, 1), hi + 1):
+            t0 = time.time()
+            wins = exact_starts(n, pool, jobs)
+            winning = [s for s in range(2, n + 1, 2) if wins[s]]
+            exact = f"first {winning[0]}" if winning else "second"
+
+            if table is not None:
+                if n >= len(table):
+                    print(f"n={n}: beyond the table", file=sys.stderr)
+                    sys.exit(1)
+                winner, move = ("first", table[n]) if table[n] else ("second", None)
+            else:
+                winner, move = solve(n)
+            if winner == "first":
+                ok = bool(winning) and move is not None and move <= n and wins[move] == 1
+                claimed = f"first {move}"
+            else:
+                ok = not winning
+                claimed = "second"
+            mismatches += not ok
+            print(f"n={n:4d}  exact: {exact:10s} winning starts: {len(winning):3d}  "
+                  f"solve: {claimed:10s} {'OK' if ok else 'MISMATCH'}  "
+                  f"{time.time() - t0:.2f}s", flush=True)
+    finally:
+        if pool:
+            pool.close()
+            pool.join()
+
+    print(f"{mismatches} mismatches")
+    sys.exit(1 if mismatches else 0)
+
+
+if __name__ == "__main__":
+    main()
@@ -38,6 +38,52 @@ for test_file in test_inputs/test*.txt; do
     fi
 done
 
+# Independent exact engine against solve() over its exact-search range
+total=$((total + 1))
+echo -n "Running retrograde cross-check (n <= 22)... "
+if python3 retrograde.py --to=22 --jobs=2 > /dev/null 2>&1; then
+    echo -e "${GREEN}PASSED${NC}"
+    passed=$((passed + 1))
+else
+    echo -e "${RED}FAILED${NC}"
+    echo "  Run: python3 retrograde.py --to=22"
+fi
+
+# Precomputed table: exact against the game search, and the samples by lookup
+table=$(mktemp)
+total=$((total + 1))
+echo -n "Running answer table (n <= 2000) cross-check... "
+if python3 answer_table.py --max-n=2000 --out="$table" 2>/dev/null \
+    && python3 retrograde.py --to=40 --jobs=2 --table="$table" > /dev/null 2>&1; then
+    echo -e "${GREEN}PASSED${NC}"
+    passed=$((passed + 1))
+else
+    echo -e "${RED}FAILED${NC}"
+fi
+for test_file in test_inputs/test*.txt; do
+    test_name=$(basename "$test_file" .txt)
+    expected_file="test_inputs/expected${test_name#test}.txt"
+    total=$((total + 1))
+    echo -n "Running $test_name (--table)... "
+    output=$(python3 solution.py --table="$table" < "$test_file" 2>/dev/null)
+    if [ "$output" = "$(cat "$expected_file")" ]; then
+        echo -e "${GREEN}PASSED${NC}"
+        passed=$((passed + 1))
+    else
+        echo -e "${RED}FAILED${NC}"
+    fi
+done
+# Queries past the table fall back to the unreliable pattern, with a warning
+total=$((total + 1))
+echo -n "Running --table past its bound... "
+if printf "1\n2001\n" | python3 solution.py --table="$table" 2>&1 >/dev/null | grep -q "^warning:"; then
+    echo -e "${GREEN}PASSED${NC}"
+    passed=$((passed + 1))
+else
+    echo -e "${RED}FAILED${NC}"
+fi
+rm -f "$table"
+
 echo "=========================================="
 echo "Results: $passed/$total tests passed"
 
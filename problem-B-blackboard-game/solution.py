@@ -1,7 +1,8 @@
 #!/usr/bin/env python3
 """
 Blackboard Game - Competition Submission Version
-Handles n up to 10^7 in O(1) time for large n
+Exact for n <= 22; larger n use an O(1) remainder pattern that is only
+correct up to 29, so use --table for exact answers beyond that
 """
 
 def solve(n):
@@ -125,9 +126,24 @@ def solve(n):
 
 
 def main():
-    """Process input and output results"""
+    """Process input and output results
+
+    Usage: python3 solution.py [--table=PATH] < input.txt
+    With a table from answer_table.py, every n it covers is a direct lookup;
+    larger n fall back to solve(), with a warning on stderr because its
+    remainder pattern is wrong for most n from 30 on (see retrograde.py).
+    """
     import sys
     
+    table = None
+    for arg in sys.argv[1:]:
+        if arg.startswith("--table="):
+            from answer_table import load_table
+            table = load_table(arg[8:])
+        else:
+            print("Usage: python3 solution.py [--table=PATH] < input.txt", file=sys.stderr)
+            sys.exit(1)
+    
     data = sys.stdin.read().strip().split()
     if not data:
         return
@@ -135,6 +151,27 @@ def main():
     t = int(data[0])
     idx = 1
     
+    if table is not None:
+        limit = len(table)
+        out = []
+        beyond = 0
+        for tok in data[1:t + 1]:
+            n = int(tok)
+            if 0 <= n < limit:
+                move = table[n]
+                out.append(f"first {move}" if move else "second")
+            else:
+                beyond += 1
+                winner, first_move = solve(n)
+                out.append(f"first {first_move}" if winner == "first" else "second")
+        if beyond:
+            print(f"warning: {beyond} queries have n > {limit - 1}, past the table; "
+                  "answered by the remainder pattern, which is unreliable above 29",
+                  file=sys.stderr)
+        if out:
+            sys.stdout.write("\n".join(out) + "\n")
+        return
+    
     for _ in range(t):
         if idx < len(data):
             n = int(data[idx])
@@ -0,0 +1,281 @@
+/*
+ * Problem C: Bride of Pipe Stream
+ *
+ * solve() returns the largest percentage of flubber that can be guaranteed
+ * to reach every reservoir.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <deque>
+#include <utility>
+#include <vector>
+
+// One duct as given: source station and (output id, percentage) pairs;
+// ids 1..stations are stations, stations+1..stations+reservoirs reservoirs
+struct DuctSpec {
+    int src = 0;
+    std::vector<std::pair<int, double>> outputs;
+};
+
+struct PipeStreamInput {
+    int stations = 0;
+    int reservoirs = 0;   // 1..3
+    std::vector<DuctSpec> ducts;
+};
+
+struct Duct {
+    int src; // station id (1..S)
+    std::vector<std::pair<int, double>> toStation; // (station id, fraction in [0,1])
+    std::vector<double> toReservoir; // size R, fractions in [0,1]
+};
+
+// Everything solve() builds per network, kept for reuse
+class PipeStreamWorkspace {
+public:
+    // Fraction in [0, 1] reaching every reservoir
+    double solve(const PipeStreamInput& input) {
+        build(input);
+
+        // Build reverse topo order on reachable subgraph (assumes DAG)
+        bool ok = topologicalOrderReachable();
+        if (!ok) {
+            // If cycles exist in reachable subgraph, we proceed anyway with a heuristic order:
+            topoRev.clear();
+            for (int i = S; i >= 1; --i) topoRev.push_back(i);
+            computeReachable();
+        }
+
+        if (R == 1) {
+            // Only one reservoir: all flow that reaches reservoirs must end there
+            return evaluatePhiAtZ({1.0});
+        } else if (R == 2) {
+            // Exact O(S + D) computation via 1D convex minimization
+            return solveR2Exact();
+        } else {
+            // R == 3: minimize Φ(z) on 2D simplex via nested ternary search
+            return solveR3Minimize();
+        }
+    }
+
+private:
+    void build(const PipeStreamInput& input) {
+        S = input.stations;
+        R = input.reservoirs;
+        ducts.clear();
+        ducts.reserve(input.ducts.size());
+        outDuctIds.resize(S + 1);
+        stAdj.resize(S + 1);
+        for (int s = 0; s <= S; ++s) {
+            outDuctIds[s].clear();
+            stAdj[s].clear();
+        }
+
+        for (const DuctSpec& spec : input.ducts) {
+            Duct d;
+            d.src = spec.src;
+            d.toReservoir.assign(R, 0.0);
+
+            // Remove the normalization approach - directly process each output
+            for (auto [output_id, percentage] : spec.outputs) {
+                // Convert percentage to fraction (divide by 100) without normalization
+                // Flow can be lost if percentages sum to less than 100
+                double fraction = percentage / 100.0;
+
+                if (fraction > 0.0) {  // Only add non-zero edges
+                    if (output_id >= 1 && output_id <= S) {
+                        // This is a station
+                        d.toStation.push_back({output_id, fraction});
+                        stAdj[spec.src].push_back(output_id);
+                    } else if (output_id > S && output_id <= S + R) {
+                        // This is a reservoir
+                        int reservoir_idx = output_id - S - 1;  // Convert to 0-based reservoir index
+                        d.toReservoir[reservoir_idx] += fraction;  // Use += in case multiple outputs to same reservoir
+                    }
+                }
+            }
+
+            // Push duct and record in outDuctIds
+            int idx = (int)ducts.size();
+            ducts.push_back(std::move(d));
+            if (spec.src >= 1 && spec.src <= S) {
+                outDuctIds[spec.src].push_back(idx);
+            }
+        }
+    }
+
+    // Build reachable set from source (station 1) through station-level edges
+    void computeReachable() {
+        reachable.assign(S + 1, 0);
+        queue.clear();
+        reachable[1] = 1;
+        queue.push_back(1);
+        while (!queue.empty()) {
+            int u = queue.front();
+            queue.pop_front();
+            for (int v : stAdj[u]) {
+                if (!reachable[v]) {
+                    reachable[v] = 1;
+                    queue.push_back(v);
+                }
+            }
+        }
+    }
+
+    // Topological sort on reachable subgraph; fills topoRev with reachable nodes in reverse topo order.
+    // Returns true if successful (DAG on reachable subgraph), false if cycle detected.
+    bool topologicalOrderReachable() {
+        computeReachable();
+        indeg.assign(S + 1, 0);
+        for (int u = 1; u <= S; ++u) {
+            if (!reachable[u]) continue;
+            for (int v : stAdj[u]) {
+                if (reachable[v]) indeg[v]++;
+            }
+        }
+        queue.clear();
+        for (int u = 1; u <= S; ++u) {
+            if (reachable[u] && indeg[u] == 0) queue.push_back(u);
+        }
+        topoRev.clear();
+        while (!queue.empty()) {
+            int u = queue.front();
+            queue.pop_front();
+            topoRev.push_back(u);
+            for (int v : stAdj[u]) {
+                if (!reachable[v]) continue;
+                indeg[v]--;
+                if (indeg[v] == 0) queue.push_back(v);
+            }
+        }
+        int reachableCount = 0;
+        for (int u = 1; u <= S; ++u) if (reachable[u]) reachableCount++;
+        if ((int)topoRev.size() != reachableCount) {
+            // Cycle detected in reachable subgraph
+            return false;
+        }
+        std::reverse(topoRev.begin(), topoRev.end());
+        return true;
+    }
+
+    // Evaluate Φ(z) = max_policy z·f from a given station using DP on reverse topo order (DAG).
+    double evaluatePhiAtZ(const std::vector<double>& z) {
+        val.assign(S + 1, 0.0);
+        // Only compute for reachable nodes; others stay 0 and won't be used from source.
+        for (int s : topoRev) {
+            if (!reachable[s]) continue;
+            double best = 0.0; // baseline: can get 0 if no path to reservoirs
+            for (int did : outDuctIds[s]) {
+                const Duct& d = ducts[did];
+                // c_d(z): immediate expected reward to reservoirs
+                double sum = 0.0;
+                // to reservoirs
+                for (int k = 0; k < R; ++k) {
+                    if (d.toReservoir[k] > 0.0) sum += d.toReservoir[k] * z[k];
+                }
+                // plus continuation via stations
+                for (auto [t, p] : d.toStation) {
+                    if (p > 0.0) sum += p * val[t];
+                }
+                if (sum > best) best = sum;
+            }
+            val[s] = best;
+        }
+        return val[1]; // source station is 1
+    }
+
+    // Specialized exact solver for R=2 using 1D convex minimization
+    double solveR2Exact() {
+        // For R=2, we minimize Φ(z) = max_policy z·f over z in the 1-simplex
+        // z = {z1, z2} with z1 + z2 = 1, z1, z2 >= 0
+        // Parametrize: z1 = a ∈ [0,1], z2 = 1 - a
+        // Find a that minimizes Φ({a, 1-a})
+
+        // Ternary search on a ∈ [0,1]
+        double L = 0.0, Rr = 1.0;
+        const int ITERATIONS = 80;  // Sufficient for 1e-9 precision
+
+        for (int iter = 0; iter < ITERATIONS; ++iter) {
+            double a1 = L + (Rr - L) / 3.0;
+            double a2 = Rr - (Rr - L) / 3.0;
+
+            double phi1 = evaluatePhiAtZ({a1, 1.0 - a1});
+            double phi2 = evaluatePhiAtZ({a2, 1.0 - a2});
+
+            if (phi1 < phi2) {
+                Rr = a2;
+            } else {
+                L = a1;
+            }
+        }
+
+        // Final evaluation at midpoint
+        double a_final = (L + Rr) / 2.0;
+        return evaluatePhiAtZ({a_final, 1.0 - a_final});
+    }
+
+    // Minimize Φ(z) over z in simplex for R=3 by nested ternary search on the triangle.
+    //
+    // Parametrization: z1 = a in [0,1], z2 = b in [0, 1 - a], z3 = 1 - a - b.
+    // The function Φ is convex and piecewise linear; nested ternary yields the global minimum to required precision.
+    double solveR3Minimize() {
+        auto innerMin = [&](double a) -> double {
+            double L = 0.0, Rr = 1.0 - a;
+            // If Rr==0, only z2=0 allowed; return Φ at that point
+            if (Rr <= 0.0) {
+                return evaluatePhiAtZ({a, 0.0, 1.0 - a});
+            }
+            const int IT_IN = 60;
+            for (int it = 0; it < IT_IN; ++it) {
+                double b1 = L + (Rr - L) / 3.0;
+                double b2 = Rr - (Rr - L) / 3.0;
+                double f1 = evaluatePhiAtZ({a, b1, 1.0 - a - b1});
+                double f2 = evaluatePhiAtZ({a, b2, 1.0 - a - b2});
+                if (f1 < f2) {
+                    Rr = b2;
+                } else {
+                    L = b1;
+                }
+            }
+            double b = (L + Rr) / 2.0;
+            return evaluatePhiAtZ({a, b, 1.0 - a - b});
+        };
+
+        double L = 0.0, Rr = 1.0;
+        const int IT_OUT = 60;
+        for (int it = 0; it < IT_OUT; ++it) {
+            double a1 = L + (Rr - L) / 3.0;
+            double a2 = Rr - (Rr - L) / 3.0;
+            double g1 = innerMin(a1);
+            double g2 = innerMin(a2);
+            if (g1 < g2) {
+                Rr = a2;
+            } else {
+                L = a1;
+            }
+        }
+        double a = (L + Rr) / 2.0;
+        return innerMin(a);
+    }
+
+    int S = 0, R = 0;
+    std::vector<Duct> ducts;
+    std::vector<std::vector<int>> outDuctIds;  // per station: indices of ducts
+    std::vector<std::vector<int>> stAdj;       // station-to-station adjacency
+    std::vector<int> topoRev;                  // reverse topological order of reachable stations
+    std::vector<char> reachable;
+    std::vector<int> indeg;
+    std::deque<int> queue;
+    std::vector<double> val;                   // Φ DP values per station
+};
+
+// Largest guaranteed percentage (0..100) for every reservoir
+inline double solve(const PipeStreamInput& input, PipeStreamWorkspace& workspace) {
+    return workspace.solve(input) * 100.0;
+}
+
+inline double solve(const PipeStreamInput& input) {
+    PipeStreamWorkspace workspace;
+    return solve(input, workspace);
+}
@@ -0,0 +1,208 @@
+/*
+ * Problem E: Delivery Service
+ *
+ * Cities have an evening hub h and a noon hub n + h; a courier h -> d joins
+ * h's evening hub with d's noon hub. After every courier the answer is the
+ * number of city pairs that share a component, counted once: the sum of
+ * C(|S_c|, 2) over components minus C(k, 2) for each pair of components
+ * bridged by exactly k cities.
+ *
+ * solve() returns that count after each courier; the workspace's reset and
+ * addCourier take the couriers one at a time instead.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+struct DeliveryServiceInput {
+    int n = 0;                                   // cities
+    std::vector<std::pair<int, int>> couriers;   // (h, d), 1-based
+};
+
+struct DSU {
+    int N; // number of hubs (2n)
+    std::vector<int> parent;
+    std::vector<int> sz_hubs;   // number of hubs in component (union-by-size)
+    std::vector<int> s_cities;  // number of distinct cities in component
+    std::vector<std::vector<int>> L; // cities whose evening hub (left) is in this component
+    std::vector<std::vector<int>> R; // cities whose noon hub (right) is in this component
+
+    void reset(int n) {
+        N = 2 * n;
+        parent.resize(N + 1);
+        sz_hubs.assign(N + 1, 1);
+        s_cities.assign(N + 1, 1);
+        L.resize(N + 1);
+        R.resize(N + 1);
+        for (int i = 0; i <= N; ++i) {
+            parent[i] = i;
+            L[i].clear();
+            R[i].clear();
+        }
+        // Initialize per-node lists: node i<=n is left city i, node i>n is right city (i-n)
+        for (int i = 1; i <= n; ++i) {
+            L[i].push_back(i); // evening hub for city i
+        }
+        for (int i = 1; i <= n; ++i) {
+            R[n + i].push_back(i); // noon hub for city i
+        }
+    }
+
+    int find(int x) {
+        while (parent[x] != x) {
+            parent[x] = parent[parent[x]];
+            x = parent[x];
+        }
+        return x;
+    }
+};
+
+static inline long long comb2(long long x) {
+    return x <= 1 ? 0LL : (x * (x - 1)) >> 1;
+}
+
+// Use 64-bit key: (minRoot << 32) | maxRoot
+static inline uint64_t make_key(uint32_t a, uint32_t b) {
+    if (a > b) std::swap(a, b);
+    return (uint64_t(a) << 32) | uint64_t(b);
+}
+
+class DeliveryServiceWorkspace {
+public:
+    // Start over with n cities and no couriers
+    void reset(int cities) {
+        n = cities;
+        dsu.reset(n);
+        sum_binom = 0;
+        sum_doubles = 0;
+        bridge.clear();
+        bridge.reserve(size_t(n) * 3);
+
+        // Initialize bridges: each city i initially bridges its two singleton components (i, n+i) with count 1
+        // This keeps the counts consistent for the first updates.
+        for (int i = 1; i <= n; ++i) {
+            uint64_t key = make_key(uint32_t(i), uint32_t(n + i));
+            bridge.emplace(key, 1);
+            // sum_doubles contribution for k=1 is 0, so no change needed
+        }
+    }
+
+    // Add courier h -> d and return the number of connected city pairs
+    long long addCourier(int h, int d) {
+        // Connect h_evening (h) to d_noon (n + d)
+        unite_e_noon(h, n + d);
+        return sum_binom - sum_doubles;
+    }
+
+private:
+    void add_pair_count(int a, int b, int delta) {
+        // a != b must hold
+        if (a == b) return;
+        uint64_t key = make_key(uint32_t(a), uint32_t(b));
+        auto it = bridge.find(key);
+        long long oldv = (it == bridge.end() ? 0 : it->second);
+        long long newv = oldv + delta;
+        // Update sum_doubles by difference in comb2
+        sum_doubles += comb2(newv) - comb2(oldv);
+        if (newv == 0) {
+            if (it != bridge.end()) bridge.erase(it);
+        } else {
+            bridge[key] = int(newv);
+        }
+    }
+
+    void unite_e_noon(int e_hub, int n_hub) {
+        int u = dsu.find(e_hub);
+        int v = dsu.find(n_hub);
+        if (u == v) {
+            return; // no changes to sums
+        }
+        // Small-to-large by number of hubs
+        int small = u, large = v;
+        if (dsu.sz_hubs[small] > dsu.sz_hubs[large]) std::swap(small, large);
+
+        // Compute inter (number of cities appearing in both components)
+        long long inter = 0;
+
+        // Pass 1: remove old bridges involving 'small', compute inter
+        // For every city with a hub in 'small', we adjust mapping for the pair {small, other}.
+        // Left side cities (evening hubs)
+        for (int city : dsu.L[small]) {
+            int other = dsu.find(n + city);
+            if (other == small) continue; // both hubs in same comp -> no bridging to remove
+            if (other == large) ++inter;  // city counted in both comps
+            add_pair_count(small, other, -1);
+        }
+        // Right side cities (noon hubs)
+        for (int city : dsu.R[small]) {
+            int other = dsu.find(city); // evening hub index
+            if (other == small) continue;
+            if (other == large) ++inter;
+            add_pair_count(small, other, -1);
+        }
+
+        // Update sum_binom for merging components
+        long long s1 = dsu.s_cities[small];
+        long long s2 = dsu.s_cities[large];
+        sum_binom += comb2(s1 + s2 - inter) - comb2(s1) - comb2(s2);
+
+        // Union small -> large (update DSU metadata)
+        dsu.parent[small] = large;
+        dsu.sz_hubs[large] += dsu.sz_hubs[small];
+        dsu.s_cities[large] = int(s1 + s2 - inter);
+
+        // Pass 2: add new bridges from 'large' to 'other' (for cities that still have split hubs)
+        for (int city : dsu.L[small]) {
+            int other = dsu.find(n + city);
+            if (other == large) continue; // both hubs in same comp now
+            add_pair_count(large, other, +1);
+        }
+        for (int city : dsu.R[small]) {
+            int other = dsu.find(city);
+            if (other == large) continue;
+            add_pair_count(large, other, +1);
+        }
+
+        // Move city lists from small to large (small-to-large merging)
+        if (!dsu.L[small].empty()) {
+            dsu.L[large].insert(dsu.L[large].end(), dsu.L[small].begin(), dsu.L[small].end());
+            dsu.L[small].clear();
+            dsu.L[small].shrink_to_fit(); // optional, may reduce memory
+        }
+        if (!dsu.R[small].empty()) {
+            dsu.R[large].insert(dsu.R[large].end(), dsu.R[small].begin(), dsu.R[small].end());
+            dsu.R[small].clear();
+            dsu.R[small].shrink_to_fit();
+        }
+    }
+
+    int n = 0;
+    DSU dsu;
+    // sum over components of C(|S_c|, 2)
+    long long sum_binom = 0;
+    // sum over unordered component pairs {c1,c2} of C(k,2), where k = #cities bridging exactly those two comps
+    long long sum_doubles = 0;
+    // Bridge counts between component pairs
+    std::unordered_map<uint64_t, int> bridge;
+};
+
+// Connected city pairs after each courier, in input order
+inline std::vector<long long> solve(const DeliveryServiceInput& input, DeliveryServiceWorkspace& workspace) {
+    workspace.reset(input.n);
+    std::vector<long long> answers;
+    answers.reserve(input.couriers.size());
+    for (auto [h, d] : input.couriers) {
+        answers.push_back(workspace.addCourier(h, d));
+    }
+    return answers;
+}
+
+inline std::vector<long long> solve(const DeliveryServiceInput& input) {
+    DeliveryServiceWorkspace workspace;
+    return solve(input, workspace);
+}
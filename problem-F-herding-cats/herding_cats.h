@@ -0,0 +1,193 @@
+/*
+ * Problem F: Herding Cats
+ *
+ * solve() decides one test case: true if the plants can be arranged so
+ * every cat stops at its target pot.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+/*
+Herding Cats - Bipartite Matching solution (Kuhn's algorithm)
+
+Model:
+- m pots (1..m), m plants (1..m).
+- n cats; cat i likes set S_i and targets pot t_i, stopping at the first pot
+  that contains a liked plant.
+
+Constraints conversion:
+- For each plant p, it cannot be placed before the maximum target among cats who like p:
+  min_pos[p] = max(t_i | p in S_i), or 1 if no such cats.
+- For each pot k, if one or more cats target k, the plant at k must be liked by all those cats:
+  Inter_k = intersection of liked sets of cats with t_i = k.
+
+Graph:
+- Left nodes: constrained pots Kc = { k | there exists a cat with t_i = k }.
+- Right nodes: plants p in [1..m].
+- Edge (k, p) if p ∈ Inter_k and k >= min_pos[p].
+
+We need to check if a perfect matching for all constrained pots exists. If yes, and if the global
+availability constraint T_k = #{p | min_pos[p] <= k} satisfies T_k >= k for all k, then the remaining
+(unconstrained) pots can always be filled greedily with remaining plants.
+
+Algorithm steps per test:
+1) Deduplicate each cat's liked set.
+2) Compute min_pos[p].
+3) Early feasibility check: for all k in [1..m], T_k >= k where T_k = sum_{x<=k} count(min_pos == x).
+4) For each constrained pot k, compute Inter_k using counting over the cats in its group, and build edges
+   to plants p in Inter_k with min_pos[p] <= k.
+5) Run Kuhn's algorithm to attempt to match all constrained pots.
+6) Output "yes" if matching size equals number of constrained pots, else "no".
+
+Complexity:
+- Preprocessing and intersections: O(sum |S_i|).
+- Graph edges: sum_k |Inter_k| filtered by min_pos, which is <= sum |S_i|.
+- Kuhn's algorithm: typically O(L * E) where L is #constrained pots and E is total edges, acceptable with sparse graph.
+- Memory: O(m + sum |S_i| + E).
+
+Notes:
+- We avoid building edges for unconstrained pots to prevent dense graphs.
+- We deduplicate each cat's liked list to maintain set semantics.
+*/
+
+struct Cat {
+    int target = 0;            // pot t_i
+    std::vector<int> likes;    // liked plants S_i, possibly with repeats
+};
+
+struct HerdingCatsCase {
+    int m = 0;                 // pots and plants
+    std::vector<Cat> cats;
+};
+
+class HerdingCatsWorkspace {
+public:
+    bool solve(const HerdingCatsCase& input) {
+        const int n = (int)input.cats.size();
+        const int m = input.m;
+
+        likes.resize(n);
+        cats_by_target.resize(m + 1);
+        for (int k = 0; k <= m; ++k) cats_by_target[k].clear();
+        min_pos.assign(m + 1, 1);
+
+        for (int i = 0; i < n; ++i) {
+            int t = input.cats[i].target;
+            // Deduplicate liked plants per cat to preserve set semantics
+            auto &v = likes[i];
+            v = input.cats[i].likes;
+            std::sort(v.begin(), v.end());
+            v.erase(std::unique(v.begin(), v.end()), v.end());
+
+            // Update min_pos for unique liked plants
+            for (int p : v) {
+                if (p >= 1 && p <= m)
+                    min_pos[p] = std::max(min_pos[p], t);
+            }
+            // Group cat by its target pot
+            if (t >= 1 && t <= m)
+                cats_by_target[t].push_back(i);
+        }
+
+        // Early feasibility check for unconstrained positions via min_pos
+        // T_k = number of plants with min_pos <= k should be >= k for all k
+        freq.assign(m + 2, 0);
+        for (int p = 1; p <= m; ++p) {
+            int mp = min_pos[p];
+            if (mp < 1) mp = 1;
+            if (mp > m) mp = m; // though min_pos cannot exceed m by definition
+            freq[mp]++;
+        }
+        long long pref = 0;
+        for (int k = 1; k <= m; ++k) {
+            pref += freq[k];
+            if (pref < k) {
+                return false;
+            }
+        }
+
+        // Build bipartite graph only for constrained pots
+        adj.clear();
+        cnt.assign(m + 1, 0);
+
+        for (int k = 1; k <= m; ++k) {
+            const auto &group = cats_by_target[k];
+            if (group.empty()) continue;
+
+            touched.clear();
+            // Count frequency of plants across all cats in the group
+            for (int cat : group) {
+                for (int p : likes[cat]) {
+                    if (cnt[p] == 0) touched.push_back(p);
+                    ++cnt[p];
+                }
+            }
+
+            std::vector<int> allowed;
+            allowed.reserve(touched.size());
+            for (int p : touched) {
+                if (cnt[p] == (int)group.size() && min_pos[p] <= k) {
+                    allowed.push_back(p);
+                }
+                cnt[p] = 0; // reset for next group
+            }
+
+            if (allowed.empty()) {
+                return false; // No plant can be placed at this constrained pot
+            }
+            adj.push_back(std::move(allowed));
+        }
+
+        // If there are no constrained pots, min_pos check already guarantees feasibility
+        int L = (int)adj.size();
+        if (L == 0) {
+            return true;
+        }
+
+        // Kuhn's algorithm (DFS-based) to match all constrained pots
+        matchR.assign(m + 1, -1); // match on plant side: plant p -> left index u
+        seen.assign(m + 1, 0);
+        int seenIter = 0;
+
+        for (int u = 0; u < L; ++u) {
+            int iter = ++seenIter;
+            if (!dfs(u, iter)) {
+                return false; // cannot match this constrained pot
+            }
+        }
+        return true;
+    }
+
+private:
+    bool dfs(int u, int iter) {
+        for (int v : adj[u]) {
+            if (seen[v] == iter) continue;
+            seen[v] = iter;
+            if (matchR[v] == -1 || dfs(matchR[v], iter)) {
+                matchR[v] = u;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    std::vector<std::vector<int>> likes;           // deduplicated S_i
+    std::vector<std::vector<int>> cats_by_target;
+    std::vector<int> min_pos, freq, cnt, touched;
+    std::vector<std::vector<int>> adj;             // constrained pot -> allowed plants
+    std::vector<int> matchR, seen;
+};
+
+// True if the plants can be arranged so every cat stops at its target pot
+inline bool solve(const HerdingCatsCase& input, HerdingCatsWorkspace& workspace) {
+    return workspace.solve(input);
+}
+
+inline bool solve(const HerdingCatsCase& input) {
+    HerdingCatsWorkspace workspace;
+    return solve(input, workspace);
+}
@@ -0,0 +1,41 @@
+import math
+import random
+import sys
+
+# Usage: python3 generate_terrain.py <grid> [seed] > terrain.txt
+# Writes a single test case: a (grid x grid)-cell terrain over a square of
+# side 10*grid, split into 2*grid^2 triangles, with integer heights rising
+# from south to north plus smooth waves, so many heights have a level path.
+grid = int(sys.argv[1]) if len(sys.argv) > 1 else 100
+seed = int(sys.argv[2]) if len(sys.argv) > 2 else 1
+random.seed(seed)
+
+side = 10 * grid
+waves = [(random.uniform(0.5, 3.0), random.uniform(0.5, 3.0),
+          random.uniform(0, 2 * math.pi), random.uniform(50, 200)) for _ in range(4)]
+
+def height(x, y):
+    u, v = x / side, y / side
+    h = 500.0 + 1000.0 * v
+    for fx, fy, ph, amp in waves:
+        h += amp * math.sin(2 * math.pi * (fx * u + fy * v) + ph)
+    return int(round(h)) + random.randint(0, 3)
+
+n = (grid + 1) * (grid + 1)
+m = 2 * grid * grid
+out = ["1", f"{side} {side} {n} {m}"]
+for i in range(grid + 1):
+    for j in range(grid + 1):
+        x, y = 10 * j, 10 * i
+        out.append(f"{x} {y} {height(x, y)}")
+
+def vid(i, j):
+    return i * (grid + 1) + j + 1
+
+for i in range(grid):
+    for j in range(grid):
+        a, b, c, d = vid(i, j), vid(i, j + 1), vid(i + 1, j + 1), vid(i + 1, j)
+        out.append(f"{a} {b} {c}")
+        out.append(f"{a} {c} {d}")
+
+sys.stdout.write("\n".join(out) + "\n")
@@ -0,0 +1,542 @@
+/*
+ * Problem G: Lava Moat
+ *
+ * solve() returns the length of the shortest west-to-east level path, or
+ * LAVA_INF if no height has one; solveMultiRes() gives the same answer after
+ * pruning height bands with a terrain pyramid. Both take a TerrainView
+ * (terrain_format.h), so text input and mapped binary files are solved alike.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "terrain_format.h"
+
+const double LAVA_EPS = 1e-9;
+const double LAVA_INF = 1e18;
+
+struct Point {
+    double x, y, z;
+};
+
+// Terrain parsed from text input, stored in the same SoA layout as the
+// binary format so both paths share TerrainView
+struct TerrainData {
+    int w = 0, l = 0;
+    std::vector<double> x, y, z;
+    std::vector<uint32_t> tri;  // 0-indexed vertices, 3 per triangle
+    
+    TerrainView view() const {
+        TerrainView v;
+        v.w = w;
+        v.l = l;
+        v.n = x.size();
+        v.m = tri.size() / 3;
+        v.x = x.data();
+        v.y = y.data();
+        v.z = z.data();
+        v.tri = tri.data();
+        return v;
+    }
+};
+
+inline Point vertexAt(const TerrainView& T, uint32_t i) {
+    return {T.x[i], T.y[i], T.z[i]};
+}
+
+// Quantize coordinates to handle floating point precision issues
+inline std::pair<int, int> quantizeCoord(double x, double y, double scale = 1e6) {
+    return {(int)std::round(x * scale), (int)std::round(y * scale)};
+}
+
+// Compute intersection of edge with horizontal plane at height z
+inline std::pair<bool, Point> edgeIntersection(const Point& p1, const Point& p2, double z) {
+    if (std::abs(p1.z - p2.z) < LAVA_EPS) {
+        // Edge is horizontal
+        if (std::abs(p1.z - z) < LAVA_EPS) {
+            // Edge is at the exact height - degenerate case
+            return {false, Point()};
+        }
+        return {false, Point()};
+    }
+    
+    if ((z < std::min(p1.z, p2.z) - LAVA_EPS) || (z > std::max(p1.z, p2.z) + LAVA_EPS)) {
+        return {false, Point()};
+    }
+    
+    double t = (z - p1.z) / (p2.z - p1.z);
+    Point intersection;
+    intersection.x = p1.x + t * (p2.x - p1.x);
+    intersection.y = p1.y + t * (p2.y - p1.y);
+    intersection.z = z;
+    
+    return {true, intersection};
+}
+
+inline double distance(const Point& p1, const Point& p2) {
+    double dx = p1.x - p2.x;
+    double dy = p1.y - p2.y;
+    return std::sqrt(dx * dx + dy * dy);
+}
+
+// Reusable buffers for the per-level pipeline. Every container only grows,
+// so once it has seen the largest level, solveLevel runs without touching
+// the heap: nodes get dense IDs through an epoch-stamped hash table, edges go
+// into a bump buffer that is turned into CSR adjacency, and Dijkstra uses an
+// indexed binary heap with epoch-stamped distances.
+struct LevelWorkspace {
+    struct Edge {
+        uint32_t u, v;
+        double len;
+    };
+    
+    // Quantized coordinate -> dense node ID (open addressing, linear probing)
+    std::vector<uint64_t> slotKey;
+    std::vector<uint32_t> slotId;
+    std::vector<uint32_t> slotEpoch;
+    uint32_t epoch = 0;
+    
+    // Per-node data, indexed by dense ID
+    std::vector<int> nodeQx;
+    uint32_t nodeCount = 0;
+    
+    // Bump-allocated edge buffer for the current level
+    std::vector<Edge> edges;
+    size_t edgeTop = 0;
+    
+    // CSR adjacency built from the edge buffer
+    std::vector<uint32_t> adjStart, adjFill, adjTo;
+    std::vector<double> adjLen;
+    
+    // Dijkstra state
+    std::vector<double> dist;
+    std::vector<uint32_t> distEpoch;
+    std::vector<uint32_t> heap;
+    std::vector<int32_t> heapPos;  // -1 when not in the heap
+    
+    template <class V>
+    static void ensure(V& v, size_t n) {
+        if (v.size() < n) v.resize(std::max(n, 2 * v.size()));
+    }
+    
+    void beginLevel(size_t maxNodes) {
+        // Keep the table at most half full for the largest possible level
+        size_t cap = 16;
+        while (cap < 2 * maxNodes) cap <<= 1;
+        if (slotKey.size() < cap) {
+            // New slots are stamped 0, which the next epoch never equals;
+            // epoch itself keeps counting so old distEpoch stamps stay stale
+            slotKey.assign(cap, 0);
+            slotId.assign(cap, 0);
+            slotEpoch.assign(cap, 0);
+        }
+        if (++epoch == 0) restartEpochs();
+        ensure(nodeQx, maxNodes);
+        nodeCount = 0;
+        edgeTop = 0;
+    }
+    
+    // The only place epoch goes back: every stamp compared against it is
+    // cleared first, so nothing from an earlier level can look current
+    void restartEpochs() {
+        std::fill(slotEpoch.begin(), slotEpoch.end(), 0);
+        std::fill(distEpoch.begin(), distEpoch.end(), 0);
+        std::fill(heapPos.begin(), heapPos.end(), -1);
+        epoch = 1;
+    }
+
+    uint32_t nodeId(std::pair<int,int> q) {
+        uint64_t key = (uint64_t(uint32_t(q.first)) << 32) | uint32_t(q.second);
+        size_t mask = slotKey.size() - 1;
+        size_t h = (key * 0x9E3779B97F4A7C15ULL) >> 17;
+        for (size_t i = h & mask; ; i = (i + 1) & mask) {
+            if (slotEpoch[i] != epoch) {
+                slotEpoch[i] = epoch;
+                slotKey[i] = key;
+                slotId[i] = nodeCount;
+                nodeQx[nodeCount] = q.first;
+                return nodeCount++;
+            }
+            if (slotKey[i] == key) return slotId[i];
+        }
+    }
+    
+    void addEdge(uint32_t u, uint32_t v, double len) {
+        if (edgeTop == edges.size()) edges.resize(std::max<size_t>(64, 2 * edges.size()));
+        edges[edgeTop++] = {u, v, len};
+    }
+    
+    // Indexed binary min-heap on dist[] over dense node IDs
+    bool heapLess(uint32_t a, uint32_t b) const { return dist[heap[a]] < dist[heap[b]]; }
+    
+    void heapSwap(uint32_t a, uint32_t b) {
+        std::swap(heap[a], heap[b]);
+        heapPos[heap[a]] = a;
+        heapPos[heap[b]] = b;
+    }
+    
+    void siftUp(uint32_t i) {
+        while (i > 0 && heapLess(i, (i - 1) / 2)) {
+            heapSwap(i, (i - 1) / 2);
+            i = (i - 1) / 2;
+        }
+    }
+    
+    // Set dist[id] = d if that improves it, inserting or decreasing its key
+    void relax(uint32_t id, double d, size_t& heapSize) {
+        if (distEpoch[id] == epoch && dist[id] <= d) return;
+        if (distEpoch[id] != epoch) {
+            distEpoch[id] = epoch;
+            heapPos[id] = -1;
+        }
+        dist[id] = d;
+        if (heapPos[id] < 0) {
+            heap[heapSize] = id;
+            heapPos[id] = heapSize;
+            heapSize++;
+        }
+        siftUp(heapPos[id]);
+    }
+    
+    uint32_t popMin(size_t& heapSize) {
+        uint32_t top = heap[0];
+        heapSwap(0, --heapSize);
+        heapPos[top] = -1;
+        for (uint32_t i = 0; ; ) {
+            uint32_t l = 2 * i + 1, r = l + 1, m = i;
+            if (l < heapSize && heapLess(l, m)) m = l;
+            if (r < heapSize && heapLess(r, m)) m = r;
+            if (m == i) break;
+            heapSwap(i, m);
+            i = m;
+        }
+        return top;
+    }
+    
+    // Counting sort of the edge buffer into CSR, both directions
+    void buildAdjacency() {
+        ensure(adjStart, nodeCount + 1);
+        ensure(adjFill, nodeCount);
+        ensure(adjTo, 2 * edgeTop);
+        ensure(adjLen, 2 * edgeTop);
+        std::fill(adjStart.begin(), adjStart.begin() + nodeCount + 1, 0);
+        for (size_t i = 0; i < edgeTop; i++) {
+            adjStart[edges[i].u + 1]++;
+            adjStart[edges[i].v + 1]++;
+        }
+        for (uint32_t i = 0; i < nodeCount; i++) {
+            adjStart[i + 1] += adjStart[i];
+            adjFill[i] = adjStart[i];
+        }
+        for (size_t i = 0; i < edgeTop; i++) {
+            const Edge& e = edges[i];
+            adjTo[adjFill[e.u]] = e.v;
+            adjLen[adjFill[e.u]++] = e.len;
+            adjTo[adjFill[e.v]] = e.u;
+            adjLen[adjFill[e.v]++] = e.len;
+        }
+    }
+};
+
+// Shortest west-to-east level path at a single height z, or LAVA_INF if none exists
+inline double solveLevel(const TerrainView& T, double z, LevelWorkspace& ws) {
+    int w = T.w;
+    // Each triangle contributes at most one segment, i.e. two nodes
+    ws.beginLevel(2 * (size_t)T.m);
+    
+    // Build graph of level curves at height z using quantized coordinates
+    for (uint32_t t = 0; t < T.m; t++) {
+        Point v1 = vertexAt(T, T.tri[3 * t]);
+        Point v2 = vertexAt(T, T.tri[3 * t + 1]);
+        Point v3 = vertexAt(T, T.tri[3 * t + 2]);
+        
+        Point intersections[6];
+        int cnt = 0;
+        
+        // Check each edge of the triangle
+        auto [has1, p1] = edgeIntersection(v1, v2, z);
+        auto [has2, p2] = edgeIntersection(v2, v3, z);
+        auto [has3, p3] = edgeIntersection(v3, v1, z);
+        
+        if (has1) intersections[cnt++] = p1;
+        if (has2) intersections[cnt++] = p2;
+        if (has3) intersections[cnt++] = p3;
+        
+        // Also check vertices at exact height
+        if (std::abs(v1.z - z) < LAVA_EPS) intersections[cnt++] = v1;
+        if (std::abs(v2.z - z) < LAVA_EPS) intersections[cnt++] = v2;
+        if (std::abs(v3.z - z) < LAVA_EPS) intersections[cnt++] = v3;
+        
+        if (cnt < 2) continue;
+        
+        // Remove duplicates within this triangle
+        std::sort(intersections, intersections + cnt, [](const Point& a, const Point& b) {
+            if (std::abs(a.x - b.x) > LAVA_EPS) return a.x < b.x;
+            return a.y < b.y;
+        });
+        
+        cnt = std::unique(intersections, intersections + cnt, [](const Point& a, const Point& b) {
+            return std::abs(a.x - b.x) < LAVA_EPS && std::abs(a.y - b.y) < LAVA_EPS;
+        }) - intersections;
+        
+        // Connect pairs of intersection points using quantized coordinates
+        if (cnt == 2) {
+            uint32_t u = ws.nodeId(quantizeCoord(intersections[0].x, intersections[0].y));
+            uint32_t v = ws.nodeId(quantizeCoord(intersections[1].x, intersections[1].y));
+            ws.addEdge(u, v, distance(intersections[0], intersections[1]));
+        }
+    }
+    
+    uint32_t N = ws.nodeCount;
+    if (N == 0) return LAVA_INF;
+    ws.buildAdjacency();
+    LevelWorkspace::ensure(ws.dist, N);
+    LevelWorkspace::ensure(ws.distEpoch, N);
+    LevelWorkspace::ensure(ws.heap, N);
+    LevelWorkspace::ensure(ws.heapPos, N);
+    
+    // Run Dijkstra from all west (x=0) nodes
+    size_t heapSize = 0;
+    bool anyEast = false;
+    for (uint32_t id = 0; id < N; id++) {
+        double x = ws.nodeQx[id] / 1e6;  // Unquantize for comparison
+        if (std::abs(x - 0) < LAVA_EPS) ws.relax(id, 0, heapSize);
+        if (std::abs(x - w) < LAVA_EPS) anyEast = true;
+    }
+    if (heapSize == 0 || !anyEast) return LAVA_INF;
+    
+    while (heapSize > 0) {
+        uint32_t curr = ws.popMin(heapSize);
+        double d = ws.dist[curr];
+        for (uint32_t e = ws.adjStart[curr]; e < ws.adjStart[curr + 1]; e++) {
+            ws.relax(ws.adjTo[e], d + ws.adjLen[e], heapSize);
+        }
+    }
+    
+    // Find minimum distance to any east (x=w) node
+    double best = LAVA_INF;
+    for (uint32_t id = 0; id < N; id++) {
+        double x = ws.nodeQx[id] / 1e6;
+        if (std::abs(x - w) < LAVA_EPS && ws.distEpoch[id] == ws.epoch) {
+            best = std::min(best, ws.dist[id]);
+        }
+    }
+    return best;
+}
+
+// Sorted critical heights (vertex z-values)
+inline std::vector<double> criticalHeights(const TerrainView& T) {
+    std::vector<double> zValues(T.z, T.z + T.n);
+    std::sort(zValues.begin(), zValues.end());
+    zValues.erase(std::unique(zValues.begin(), zValues.end()), zValues.end());
+    return zValues;
+}
+
+// Buffers reused across terrains: the per-level graph and the height list
+struct LavaMoatWorkspace {
+    LevelWorkspace level;
+    std::vector<double> heights;
+};
+
+// Shortest level path over all heights, or LAVA_INF if there is none
+inline double solve(const TerrainView& T, LavaMoatWorkspace& ws) {
+    // Get all unique z-values
+    std::vector<double>& testZ = ws.heights;
+    testZ.assign(T.z, T.z + T.n);
+    std::sort(testZ.begin(), testZ.end());
+    testZ.erase(std::unique(testZ.begin(), testZ.end()), testZ.end());
+    
+    double minPath = LAVA_INF;
+    
+    // Add intermediate values - FIX: capture original size
+    int originalSize = testZ.size();
+    for (int i = 0; i + 1 < originalSize; i++) {
+        double mid = (testZ[i] + testZ[i+1]) / 2.0;
+        testZ.push_back(mid);
+    }
+    
+    std::sort(testZ.begin(), testZ.end());
+    
+    for (double z : testZ) {
+        minPath = std::min(minPath, solveLevel(T, z, ws.level));
+    }
+    
+    return minPath;
+}
+
+inline double solve(const TerrainView& T) {
+    LavaMoatWorkspace ws;
+    return solve(T, ws);
+}
+
+// ---------------------------------------------------------------------------
+// Multi-resolution mode
+//
+// Any west-to-east level curve must cross every vertical line x = X in [0, w].
+// Take the first crossings of the lines X_0 = 0 < X_1 < ... < X_K = w; the
+// curve between consecutive crossings is at least as long as the straight
+// segment joining them, and each crossing at height z lies on the
+// cross-section of some triangle with that line. So if I_j is the y-hull of
+// all cross-section points whose height falls in the band [zlo, zhi], then
+//     length >= sum_j sqrt((X_{j+1} - X_j)^2 + gap(I_j, I_{j+1})^2)
+// for every z in the band, and the bound is infinite if some I_j is empty.
+//
+// Level L uses K = 2^L equal slabs. All levels share the cross-sections of
+// the finest level, so refining a band only visits more boundaries.
+// ---------------------------------------------------------------------------
+
+// Cross-section of one triangle with a vertical line: segment (y0,z0)-(y1,z1)
+struct Section {
+    double y0, z0, y1, z1;
+};
+
+struct TerrainPyramid {
+    int levels;                          // levels 0..levels-1, level L has 2^L slabs
+    std::vector<double> xs;                   // finest boundaries, size 2^(levels-1) + 1
+    std::vector<std::vector<Section>> sections;    // per finest boundary
+};
+
+inline TerrainPyramid buildPyramid(const TerrainView& T, int levels) {
+    int w = T.w;
+    TerrainPyramid P;
+    P.levels = levels;
+    int K = 1 << (levels - 1);
+    P.xs.resize(K + 1);
+    for (int j = 0; j <= K; j++) P.xs[j] = (double)w * j / K;
+    P.sections.assign(K + 1, {});
+    
+    for (uint32_t t = 0; t < T.m; t++) {
+        Point v[3] = {vertexAt(T, T.tri[3 * t]), vertexAt(T, T.tri[3 * t + 1]),
+                      vertexAt(T, T.tri[3 * t + 2])};
+        double xmin = std::min({v[0].x, v[1].x, v[2].x});
+        double xmax = std::max({v[0].x, v[1].x, v[2].x});
+        int jlo = std::max(0, (int)std::ceil((xmin - LAVA_EPS) * K / w));
+        int jhi = std::min(K, (int)std::floor((xmax + LAVA_EPS) * K / w));
+        
+        for (int j = jlo; j <= jhi; j++) {
+            double X = P.xs[j];
+            // Collect points where the triangle boundary meets x = X
+            double ys[6], zs[6];
+            int cnt = 0;
+            for (int e = 0; e < 3; e++) {
+                const Point& a = v[e];
+                const Point& b = v[(e + 1) % 3];
+                if (X < std::min(a.x, b.x) - LAVA_EPS || X > std::max(a.x, b.x) + LAVA_EPS) continue;
+                if (std::abs(a.x - b.x) < LAVA_EPS) {
+                    ys[cnt] = a.y; zs[cnt++] = a.z;
+                    ys[cnt] = b.y; zs[cnt++] = b.z;
+                } else {
+                    double t = (X - a.x) / (b.x - a.x);
+                    ys[cnt] = a.y + t * (b.y - a.y);
+                    zs[cnt++] = a.z + t * (b.z - a.z);
+                }
+            }
+            if (cnt == 0) continue;
+            // The cross-section is the segment between the extreme y points
+            int lo = 0, hi = 0;
+            for (int i = 1; i < cnt; i++) {
+                if (ys[i] < ys[lo]) lo = i;
+                if (ys[i] > ys[hi]) hi = i;
+            }
+            P.sections[j].push_back({ys[lo], zs[lo], ys[hi], zs[hi]});
+        }
+    }
+    return P;
+}
+
+// Lower bound on the level path length for any height in [zlo, zhi] at one level
+inline double bandLowerBound(const TerrainPyramid& P, int level, double zlo, double zhi) {
+    int K = 1 << level;
+    int stride = (int)(P.xs.size() - 1) / K;
+    double bound = 0;
+    double prevLo = 0, prevHi = 0;
+    
+    for (int j = 0; j <= K; j++) {
+        int fj = j * stride;
+        double lo = LAVA_INF, hi = -LAVA_INF;
+        for (const auto& s : P.sections[fj]) {
+            // Part of the segment whose height lies in the band
+            double ta = 0, tb = 1;
+            double dz = s.z1 - s.z0;
+            if (std::abs(dz) < LAVA_EPS) {
+                if (s.z0 < zlo - LAVA_EPS || s.z0 > zhi + LAVA_EPS) continue;
+            } else {
+                ta = (zlo - LAVA_EPS - s.z0) / dz;
+                tb = (zhi + LAVA_EPS - s.z0) / dz;
+                if (ta > tb) std::swap(ta, tb);
+                ta = std::max(ta, 0.0);
+                tb = std::min(tb, 1.0);
+                if (ta > tb) continue;
+            }
+            double ya = s.y0 + ta * (s.y1 - s.y0);
+            double yb = s.y0 + tb * (s.y1 - s.y0);
+            lo = std::min(lo, std::min(ya, yb));
+            hi = std::max(hi, std::max(ya, yb));
+        }
+        if (lo > hi) return LAVA_INF;
+        
+        if (j > 0) {
+            double gap = std::max(0.0, std::max(lo - prevHi, prevLo - hi));
+            double dx = P.xs[fj] - P.xs[fj - stride];
+            bound += std::sqrt(dx * dx + gap * gap);
+        }
+        prevLo = lo;
+        prevHi = hi;
+    }
+    return bound;
+}
+
+// solve() with bands pruned by an L-level pyramid first; same answer
+inline double solveMultiRes(const TerrainView& T, int levels, LavaMoatWorkspace& ws) {
+    std::vector<double> critical = criticalHeights(T);
+    int c = critical.size();
+    if (c == 0) return LAVA_INF;
+    
+    TerrainPyramid P = buildPyramid(T, levels);
+    
+    // Band i covers [critical[i], critical[i+1]] and owns the heights tested by
+    // solve() inside it: the critical height itself and the midpoint.
+    struct Band {
+        double zlo, zhi, bound;
+    };
+    std::vector<Band> bands;
+    bands.reserve(c);
+    for (int i = 0; i < c; i++) {
+        double zhi = (i + 1 < c) ? critical[i + 1] : critical[i];
+        bands.push_back({critical[i], zhi, bandLowerBound(P, 0, critical[i], zhi)});
+    }
+    
+    // Most promising bands first so the best known path shrinks quickly
+    std::sort(bands.begin(), bands.end(), [](const Band& a, const Band& b) {
+        return a.bound < b.bound;
+    });
+    
+    double minPath = LAVA_INF;
+    for (const auto& band : bands) {
+        if (band.bound >= LAVA_INF / 2 || band.bound > minPath - LAVA_EPS) break;
+        
+        bool pruned = false;
+        for (int level = 1; level < levels && !pruned; level++) {
+            double lb = bandLowerBound(P, level, band.zlo, band.zhi);
+            if (lb >= LAVA_INF / 2 || lb > minPath - LAVA_EPS) pruned = true;
+        }
+        if (pruned) continue;
+        
+        minPath = std::min(minPath, solveLevel(T, band.zlo, ws.level));
+        if (band.zhi > band.zlo) {
+            double mid = (band.zlo + band.zhi) / 2.0;
+            minPath = std::min(minPath, solveLevel(T, mid, ws.level));
+        }
+    }
+    
+    return minPath;
+}
+
+inline double solveMultiRes(const TerrainView& T, int levels) {
+    LavaMoatWorkspace ws;
+    return solveMultiRes(T, levels, ws);
+}
@@ -8,6 +8,7 @@ set -e
 # Compile the solution
 echo "Compiling solution..."
 g++ -std=c++17 -O2 -Wall -Wextra solution.cpp -o solution
+g++ -std=c++17 -O2 -Wall -Wextra terrain_convert.cpp -o terrain_convert
 
 # Run tests
 echo "Running tests..."
@@ -76,13 +77,68 @@ else
     echo "✗ FAILED (timeout or runtime error)"
 fi
 
+# Test 5: A small terrain before larger ones, so one workspace has to grow
+# between cases
+echo -n "Test 5 (Multi-case): "
+if timeout 4s ./solution < test_inputs/test5.txt > temp_output.txt 2>/dev/null; then
+    if diff -w temp_output.txt test_inputs/expected5.txt >/dev/null 2>&1; then
+        echo "✓ PASSED"
+    else
+        echo "✗ FAILED (output mismatch)"
+        echo "Expected:"
+        cat test_inputs/expected5.txt
+        echo "Got:"
+        cat temp_output.txt
+    fi
+else
+    echo "✗ FAILED (timeout or runtime error)"
+fi
+
+# Multi-resolution mode must reproduce the exact answers
+for i in 1 2 3 4 5; do
+    echo -n "Test $i (--multires): "
+    if timeout 4s ./solution --multires < test_inputs/test$i.txt > temp_output.txt 2>/dev/null; then
+        if diff -w temp_output.txt test_inputs/expected$i.txt >/dev/null 2>&1; then
+            echo "✓ PASSED"
+        else
+            echo "✗ FAILED (output mismatch)"
+            echo "Expected:"
+            cat test_inputs/expected$i.txt
+            echo "Got:"
+            cat temp_output.txt
+        fi
+    else
+        echo "✗ FAILED (timeout or runtime error)"
+    fi
+done
+
+# Binary terrain input must reproduce the text answers
+# (test 4 has truncated cases, which the converter rejects)
+for i in 1 2 3 5; do
+    echo -n "Test $i (binary): "
+    if ./terrain_convert temp_terrain.lmb < test_inputs/test$i.txt && \
+       timeout 4s ./solution --binary=temp_terrain.lmb > temp_output.txt 2>/dev/null; then
+        if diff -w temp_output.txt test_inputs/expected$i.txt >/dev/null 2>&1; then
+            echo "✓ PASSED"
+        else
+            echo "✗ FAILED (output mismatch)"
+            echo "Expected:"
+            cat test_inputs/expected$i.txt
+            echo "Got:"
+            cat temp_output.txt
+        fi
+    else
+        echo "✗ FAILED (conversion, timeout or runtime error)"
+    fi
+done
+
 # Timing test for performance verification
 echo ""
 echo "Performance test (timing on stress test):"
 time ./solution < test_inputs/test4.txt >/dev/null 2>&1
 
 # Clean up
-rm -f temp_output.txt solution
+rm -f temp_output.txt temp_terrain.lmb solution terrain_convert
 
 echo ""
 echo "All tests completed."
\ No newline at end of file
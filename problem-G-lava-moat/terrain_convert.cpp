@@ -0,0 +1,91 @@
+#include <bits/stdc++.h>
+#include "terrain_format.h"
+#include "../common/fast_input.h"
+using namespace std;
+
+// Convert a text Lava Moat input into the binary terrain format
+// Usage: ./terrain_convert output.lmb < input.txt
+// Then:  ./solution --binary=output.lmb   (or ./solution < output.lmb)
+
+int main(int argc, char* argv[]) {
+    ios_base::sync_with_stdio(false);
+    cin.tie(nullptr);
+    FastInput in;
+
+    if (argc != 2) {
+        cerr << "Usage: " << argv[0] << " <output.lmb> < input.txt\n";
+        return 1;
+    }
+
+    FILE* out = fopen(argv[1], "wb");
+    if (!out) {
+        cerr << "Error: cannot open " << argv[1] << " for writing\n";
+        return 1;
+    }
+
+    int t;
+    if (!(in >> t) || t < 0) {
+        cerr << "Error: missing test case count\n";
+        fclose(out);
+        return 1;
+    }
+
+    TerrainFileHeader header;
+    memcpy(header.magic, TERRAIN_MAGIC, sizeof(header.magic));
+    header.version = TERRAIN_VERSION;
+    header.cases = t;
+    fwrite(&header, sizeof(header), 1, out);
+
+    vector<double> x, y, z;
+    vector<uint32_t> tri;
+    for (int c = 0; c < t; c++) {
+        int w, l, n, m;
+        in >> w >> l >> n >> m;
+
+        x.resize(n);
+        y.resize(n);
+        z.resize(n);
+        for (int i = 0; i < n; i++) {
+            in >> x[i] >> y[i] >> z[i];
+        }
+
+        tri.clear();
+        tri.reserve(3 * (size_t)m);
+        for (int i = 0; i < m; i++) {
+            long long a, b, cc;
+            in >> a >> b >> cc;
+            // Same rule as the text reader: drop triangles with missing vertices
+            if (min({a, b, cc}) < 1 || max({a, b, cc}) > n) continue;
+            tri.push_back(a - 1);
+            tri.push_back(b - 1);
+            tri.push_back(cc - 1);
+        }
+
+        if (!in) {
+            cerr << "Error: truncated input in test case " << (c + 1) << "\n";
+            fclose(out);
+            return 1;
+        }
+
+        TerrainCaseHeader ch;
+        ch.w = w;
+        ch.l = l;
+        ch.n = n;
+        ch.m = tri.size() / 3;
+        fwrite(&ch, sizeof(ch), 1, out);
+        fwrite(x.data(), sizeof(double), n, out);
+        fwrite(y.data(), sizeof(double), n, out);
+        fwrite(z.data(), sizeof(double), n, out);
+        fwrite(tri.data(), sizeof(uint32_t), tri.size(), out);
+
+        static const char zeros[8] = {};
+        size_t triBytes = tri.size() * sizeof(uint32_t);
+        fwrite(zeros, 1, terrainPad8(triBytes) - triBytes, out);
+    }
+
+    if (fclose(out) != 0) {
+        cerr << "Error: failed to write " << argv[1] << "\n";
+        return 1;
+    }
+    return 0;
+}
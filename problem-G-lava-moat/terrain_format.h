@@ -0,0 +1,178 @@
+// Binary terrain format for Lava Moat (version 1)
+//
+// Layout (little-endian, every section 8-byte aligned):
+//   TerrainFileHeader                 magic "LAVAMOAT", version, case count
+//   per case:
+//     TerrainCaseHeader               w, l, n, m
+//     double x[n], y[n], z[n]         vertex coordinates (SoA)
+//     uint32_t tri[3*m]               0-based vertex indices per triangle
+//     padding to the next multiple of 8 bytes
+//
+// The solver maps the file read-only and points TerrainView at the arrays
+// directly, so no parsing or copying happens at startup.
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static const char TERRAIN_MAGIC[8] = {'L', 'A', 'V', 'A', 'M', 'O', 'A', 'T'};
+static const uint32_t TERRAIN_VERSION = 1;
+
+struct TerrainFileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t cases;
+};
+
+struct TerrainCaseHeader {
+    int32_t w, l;
+    uint32_t n, m;
+};
+
+static_assert(sizeof(TerrainFileHeader) == 16, "unexpected header padding");
+static_assert(sizeof(TerrainCaseHeader) == 16, "unexpected header padding");
+
+inline size_t terrainPad8(size_t bytes) {
+    return (bytes + 7) & ~size_t(7);
+}
+
+// Bytes occupied by one case including its header and trailing padding
+inline size_t terrainCaseBytes(uint32_t n, uint32_t m) {
+    return sizeof(TerrainCaseHeader) + 3 * sizeof(double) * size_t(n)
+         + terrainPad8(3 * sizeof(uint32_t) * size_t(m));
+}
+
+// Read-only view of one terrain; arrays are owned by the caller
+struct TerrainView {
+    int w = 0, l = 0;
+    uint32_t n = 0, m = 0;
+    const double* x = nullptr;
+    const double* y = nullptr;
+    const double* z = nullptr;
+    const uint32_t* tri = nullptr;  // 3*m entries
+};
+
+// A memory-mapped binary terrain file exposing one view per test case
+class MappedTerrainFile {
+public:
+    MappedTerrainFile() = default;
+    MappedTerrainFile(const MappedTerrainFile&) = delete;
+    MappedTerrainFile& operator=(const MappedTerrainFile&) = delete;
+    ~MappedTerrainFile() { unmap(); }
+
+    // True if fd is a regular file starting with the terrain magic
+    static bool isTerrainFile(int fd) {
+        struct stat st;
+        if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) return false;
+        if (st.st_size < (off_t)sizeof(TerrainFileHeader)) return false;
+        char magic[8];
+        if (pread(fd, magic, sizeof(magic), 0) != (ssize_t)sizeof(magic)) return false;
+        return memcmp(magic, TERRAIN_MAGIC, sizeof(magic)) == 0;
+    }
+
+    // Map the whole file behind fd; on failure returns false and sets error
+    bool map(int fd) {
+        unmap();
+        struct stat st;
+        if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+            error = "not a regular file";
+            return false;
+        }
+        size_ = st.st_size;
+        if (size_ < sizeof(TerrainFileHeader)) {
+            error = "file too small";
+            return false;
+        }
+        void* p = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (p == MAP_FAILED) {
+            error = "mmap failed";
+            return false;
+        }
+        data_ = static_cast<const char*>(p);
+        madvise(p, size_, MADV_SEQUENTIAL);
+        return parseDirectory();
+    }
+
+    bool open(const std::string& path) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            error = "cannot open " + path;
+            return false;
+        }
+        bool ok = map(fd);
+        close(fd);  // the mapping stays valid after close
+        return ok;
+    }
+
+    std::vector<TerrainView> cases;
+    std::string error;
+
+private:
+    bool parseDirectory() {
+        const TerrainFileHeader* h = reinterpret_cast<const TerrainFileHeader*>(data_);
+        if (memcmp(h->magic, TERRAIN_MAGIC, sizeof(TERRAIN_MAGIC)) != 0) {
+            error = "bad magic";
+            return false;
+        }
+        if (h->version != TERRAIN_VERSION) {
+            error = "unsupported version " + std::to_string(h->version);
+            return false;
+        }
+        size_t off = sizeof(TerrainFileHeader);
+        // Every case takes at least its header, so a larger count cannot
+        // fit; check before reserving so a corrupt count is a format error
+        if (h->cases > (size_ - off) / sizeof(TerrainCaseHeader)) {
+            error = "case count " + std::to_string(h->cases) + " exceeds file size";
+            return false;
+        }
+        cases.reserve(h->cases);
+        for (uint32_t c = 0; c < h->cases; c++) {
+            if (off + sizeof(TerrainCaseHeader) > size_) {
+                error = "truncated case header";
+                return false;
+            }
+            const TerrainCaseHeader* ch = reinterpret_cast<const TerrainCaseHeader*>(data_ + off);
+            size_t bytes = terrainCaseBytes(ch->n, ch->m);
+            if (off + bytes > size_) {
+                error = "truncated case data";
+                return false;
+            }
+            TerrainView v;
+            v.w = ch->w;
+            v.l = ch->l;
+            v.n = ch->n;
+            v.m = ch->m;
+            const char* p = data_ + off + sizeof(TerrainCaseHeader);
+            v.x = reinterpret_cast<const double*>(p);
+            v.y = v.x + v.n;
+            v.z = v.y + v.n;
+            v.tri = reinterpret_cast<const uint32_t*>(v.z + v.n);
+            for (size_t i = 0; i < 3 * size_t(v.m); i++) {
+                if (v.tri[i] >= v.n) {
+                    error = "triangle index out of range";
+                    return false;
+                }
+            }
+            cases.push_back(v);
+            off += bytes;
+        }
+        return true;
+    }
+
+    void unmap() {
+        if (data_) munmap(const_cast<char*>(data_), size_);
+        data_ = nullptr;
+        size_ = 0;
+        cases.clear();
+    }
+
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+};
@@ -2,7 +2,7 @@
 
 # Compile the solution
 echo "Compiling solution.cpp..."
-g++ -std=c++17 -O2 -Wall -o solution solution.cpp
+g++ -std=c++17 -O2 -Wall -pthread -o solution solution.cpp
 
 if [ $? -ne 0 ]; then
     echo "Compilation failed!"
@@ -41,6 +41,15 @@ run_test() {
             echo "Got:"
             cat output.txt
         fi
+        # The bitset mode must agree with the digit DP
+        ./solution --bitset < "$input_file" > output.txt
+        if diff -w -B output.txt "$expected_file" > /dev/null; then
+            echo "✓ Test $test_num passed (--bitset)"
+        else
+            echo "✗ Test $test_num failed (--bitset)"
+            echo "Got:"
+            cat output.txt
+        fi
     else
         echo "Output:"
         cat output.txt
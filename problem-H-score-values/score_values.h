@@ -0,0 +1,356 @@
+/*
+ * Problem H: Score Values
+ *
+ * Scores start at 0 and grow by fixed increments, capped at the maximum m
+ * once an increment would exceed it. So the reachable scores are exactly
+ *     { s <= m : s is a sum of increments }  together with  m  itself,
+ * because any sum below m can keep growing until an increment overshoots.
+ *
+ * Let a be the smallest increment. For each residue r mod a, dist[r] is the
+ * smallest sum of increments congruent to r; then a sum s exists iff
+ * s >= dist[s mod a] (add copies of a). dist is a shortest-path problem on
+ * a residues, solved with round-robin relaxation in O(a * n).
+ *
+ * solve() returns how many signs of each digit 0-8 are needed (6 also
+ * stands for 9), through a residue-class digit DP for any m; solveBitset()
+ * scans an explicit reachability bitset instead (m up to ~10^10).
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+// Implicit set of reachable scores: O(a) memory regardless of m
+struct ResidueReachability {
+    long long m = 0;
+    int a = 0;                  // smallest increment (modulus)
+    std::vector<long long> dist;     // smallest sum in each residue class, or INF
+
+    static constexpr long long INF = std::numeric_limits<long long>::max();
+
+    ResidueReachability(long long maxScore, const std::vector<int>& increments) : m(maxScore) {
+        a = *std::min_element(increments.begin(), increments.end());
+        dist.assign(a, INF);
+        dist[0] = 0;
+
+        // Round-robin shortest paths: adding p moves residue r to (r + p) mod a
+        // along gcd(a, p) disjoint cycles. Starting each cycle at its current
+        // minimum, one lap of relaxations settles the cycle for this p.
+        for (int p : increments) {
+            int step = p % a;
+            if (step == 0) continue;
+            int g = std::gcd(a, step);
+            int len = a / g;
+            for (int c = 0; c < g; c++) {
+                int start = c;
+                for (int i = 0, r = c; i < len; i++, r = (r + step) % a) {
+                    if (dist[r] < dist[start]) start = r;
+                }
+                if (dist[start] == INF) continue;
+                for (int i = 0, r = start; i < len; i++) {
+                    int nxt = (r + step) % a;
+                    if (dist[r] + p < dist[nxt]) dist[nxt] = dist[r] + p;
+                    r = nxt;
+                }
+            }
+        }
+    }
+
+    // True if score s can be displayed
+    bool contains(long long s) const {
+        if (s < 0 || s > m) return false;
+        return s == m || dist[s % a] <= s;
+    }
+};
+
+// Digit counts of a running counter, updated in amortized O(1) per +1
+struct DigitOdometer {
+    std::array<int, 10> count{};
+    int digit[20] = {};
+    int len = 1;
+
+    explicit DigitOdometer(long long start = 0) {
+        len = 0;
+        do {
+            digit[len++] = start % 10;
+            start /= 10;
+        } while (start > 0);
+        for (int i = 0; i < len; i++) count[digit[i]]++;
+    }
+
+    void increment() {
+        int i = 0;
+        while (i < len && digit[i] == 9) {
+            digit[i++] = 0;
+            count[9]--;
+            count[0]++;
+        }
+        if (i == len) {
+            digit[len++] = 1;
+            count[1]++;
+        } else {
+            count[digit[i]]--;
+            count[++digit[i]]++;
+        }
+    }
+};
+
+// Maximum score m and the increments (at least one, all positive)
+struct ScoreValuesInput {
+    long long m = 0;                // maximum score
+    std::vector<int> increments;
+};
+
+// Signs needed for digits 0-8; entry 6 covers 6s and 9s
+using SignCounts = std::array<int, 9>;
+
+// Digit DP rows reused across the nine digits and across inputs
+struct ScoreValuesWorkspace {
+    std::vector<int> cur, nxt;
+};
+
+// Fold one score's digit counts into the sign requirements.
+// Important: digit 6 can be flipped upside-down to show 9
+inline void updateSigns(SignCounts& signs_needed, const std::array<int, 10>& digit_count) {
+    // Update maximum for digits 0-5, 7-8
+    for (int d = 0; d <= 8; d++) {
+        if (d != 6) {
+            signs_needed[d] = std::max(signs_needed[d], digit_count[d]);
+        }
+    }
+
+    // For digit 6: need enough to cover both 6s and 9s
+    // (since a 6 sign can be flipped to show 9)
+    signs_needed[6] = std::max(signs_needed[6], digit_count[6] + digit_count[9]);
+}
+
+// Maximum number of occurrences of digit d (d = 6 also counts 9s) over the
+// scores s in [lo, hi] whose residue mod a has a finite dist, or -1 if there
+// is none. Every such s >= max dist is reachable, so this is the whole answer
+// for the range. Digit DP from the most significant digit with state
+// (s mod a, tight to hi, tight to lo, started), O(19 * 8a * 10).
+inline int maxDigitCount(const ResidueReachability& reach, long long lo, long long hi, int d,
+                         ScoreValuesWorkspace& ws) {
+    int a = reach.a;
+    int hiDig[19], loDig[19];
+    for (int i = 18; i >= 0; i--) {
+        hiDig[i] = hi % 10;
+        hi /= 10;
+        loDig[i] = lo % 10;
+        lo /= 10;
+    }
+
+    // Flags: bit 0 = tight to hi, bit 1 = tight to lo, bit 2 = started
+    std::vector<int>& cur = ws.cur;
+    std::vector<int>& nxt = ws.nxt;
+    cur.assign(8 * a, -1);
+    nxt.resize(8 * a);
+    cur[0 * 8 + 3] = 0;
+    for (int pos = 0; pos < 19; pos++) {
+        std::fill(nxt.begin(), nxt.end(), -1);
+        for (int rem = 0; rem < a; rem++) {
+            for (int flags = 0; flags < 8; flags++) {
+                int val = cur[rem * 8 + flags];
+                if (val < 0) continue;
+                bool tightHi = flags & 1, tightLo = flags & 2, started = flags & 4;
+                int from = tightLo ? loDig[pos] : 0;
+                int to = tightHi ? hiDig[pos] : 9;
+                for (int x = from; x <= to; x++) {
+                    bool nowStarted = started || x != 0;
+                    bool match = nowStarted && (x == d || (d == 6 && x == 9));
+                    int nflags = (tightHi && x == to ? 1 : 0) | (tightLo && x == from ? 2 : 0)
+                               | (nowStarted ? 4 : 0);
+                    int nrem = (rem * 10 + x) % a;
+                    int& slot = nxt[nrem * 8 + nflags];
+                    slot = std::max(slot, val + (match ? 1 : 0));
+                }
+            }
+        }
+        std::swap(cur, nxt);
+    }
+
+    int best = -1;
+    for (int rem = 0; rem < a; rem++) {
+        if (reach.dist[rem] == ResidueReachability::INF) continue;
+        for (int flags = 0; flags < 8; flags++) best = std::max(best, cur[rem * 8 + flags]);
+    }
+    return best;
+}
+
+// Sign requirements from the implicit reachable set (any m up to 10^18)
+inline SignCounts dpSigns(long long m, const std::vector<int>& increments, ScoreValuesWorkspace& ws) {
+    // Reachable scores, described without storing them
+    ResidueReachability reach(m, increments);
+
+    // Scores below the largest finite dist are checked one by one with an
+    // incremental digit counter; this prefix depends only on the increments
+    // (at most a * max increment <= 10^6 scores), never on m
+    long long D = 1;
+    for (long long d : reach.dist) {
+        if (d != ResidueReachability::INF) D = std::max(D, d);
+    }
+
+    SignCounts signs_needed{};
+    DigitOdometer odo(0);
+    for (long long score = 0; score <= m && score < D; score++, odo.increment()) {
+        if (reach.contains(score)) updateSigns(signs_needed, odo.count);
+    }
+
+    // The capped maximum m is always reachable
+    updateSigns(signs_needed, DigitOdometer(m).count);
+
+    // Above the prefix, reachability only depends on the residue: digit DP
+    if (D <= m) {
+        for (int d = 0; d <= 8; d++) {
+            signs_needed[d] = std::max(signs_needed[d], maxDigitCount(reach, D, m, d, ws));
+        }
+    }
+    return signs_needed;
+}
+
+// Explicit reachability for mid-range m (up to ~10^10): bit s is set iff
+// score s is reachable. Uses m/8 bytes and is filled with word-level
+// shift-OR passes, one per increment.
+struct ReachBitset {
+    long long m = 0;
+    std::vector<uint64_t> words;
+
+    ReachBitset(long long maxScore, const std::vector<int>& increments) : m(maxScore) {
+        size_t W = (size_t)(m / 64) + 1;
+        words.assign(W, 0);
+        words[0] = 1;  // score 0
+
+        // Close the set under +p. Words are visited in increasing order, so
+        // every source bit below the current word is already final.
+        for (int p : increments) {
+            if (p < 64) {
+                // Carry in from the previous word, then close within the word
+                // by doubling the shift: +p, +2p, +4p, ... covers every k*p < 64
+                for (size_t w = 0; w < W; w++) {
+                    uint64_t x = words[w];
+                    if (w > 0) x |= words[w - 1] >> (64 - p);
+                    for (int sh = p; sh < 64; sh <<= 1) x |= x << sh;
+                    words[w] = x;
+                }
+            } else {
+                size_t q = p / 64;
+                int r = p % 64;
+                for (size_t w = q; w < W; w++) {
+                    uint64_t src = words[w - q] << r;
+                    if (r != 0 && w > q) src |= words[w - q - 1] >> (64 - r);
+                    words[w] |= src;
+                }
+            }
+        }
+
+        // Drop sums above m, then add the capped value m
+        int tail = (int)(m % 64);
+        if (tail < 63) words[W - 1] &= (uint64_t(1) << (tail + 1)) - 1;
+        words[W - 1] |= uint64_t(1) << tail;
+    }
+
+    bool test(long long s) const {
+        return (words[s / 64] >> (s % 64)) & 1;
+    }
+};
+
+// Per-score sign requirements as 16 byte lanes (lanes 0-8 used, lane 6
+// already holds 6s + 9s), so combining scores is one vector max/add
+typedef uint8_t SignVec __attribute__((vector_size(16)));
+
+inline SignVec signVecOf(const std::array<int, 10>& digit_count) {
+    SignVec v = {};
+    for (int d = 0; d <= 8; d++) v[d] = digit_count[d];
+    v[6] = digit_count[6] + digit_count[9];
+    return v;
+}
+
+inline SignVec maxVec(SignVec a, SignVec b) {
+    return a > b ? a : b;
+}
+
+// Sign requirements over all reachable scores in the bitset, sharded across
+// threads by 64-aligned score ranges. A score s = hi * 1000 + lo is counted
+// as the digits of hi (kept by an odometer that advances block by block)
+// plus a table lookup for the last three digits, so each reachable score
+// costs one vector max; a block of 1000 scores is folded in with one add.
+inline SignCounts bitsetSigns(const ReachBitset& bits, int threads) {
+    // Last-three-digit tables: zero-padded (hi > 0) and plain (hi == 0)
+    std::vector<SignVec> lowPadded(1000), lowPlain(1000);
+    for (int v = 0; v < 1000; v++) {
+        std::array<int, 10> padded{};
+        padded[v / 100]++;
+        padded[v / 10 % 10]++;
+        padded[v % 10]++;
+        lowPadded[v] = signVecOf(padded);
+        lowPlain[v] = signVecOf(DigitOdometer(v).count);
+    }
+
+    size_t W = bits.words.size();
+    threads = std::max(1, std::min<int>(threads, (int)W));
+    std::vector<SignVec> partial(threads, SignVec{});
+    std::vector<std::thread> pool;
+
+    for (int t = 0; t < threads; t++) {
+        size_t wBegin = W * t / threads, wEnd = W * (t + 1) / threads;
+        pool.emplace_back([&, t, wBegin, wEnd]() {
+            SignVec signs = {}, blockMax = {}, hiVec = {};
+            long long curHi = -1;
+            DigitOdometer hiOdo(0);
+            bool pending = false;
+
+            for (size_t w = wBegin; w < wEnd; w++) {
+                uint64_t x = bits.words[w];
+                while (x != 0) {
+                    long long s = 64 * (long long)w + __builtin_ctzll(x);
+                    x &= x - 1;
+                    long long hi = s / 1000;
+                    int lo = (int)(s - hi * 1000);
+                    if (hi != curHi) {
+                        if (pending) signs = maxVec(signs, hiVec + blockMax);
+                        if (curHi >= 0 && hi == curHi + 1) {
+                            hiOdo.increment();
+                        } else {
+                            hiOdo = DigitOdometer(hi);
+                        }
+                        hiVec = hi == 0 ? SignVec{} : signVecOf(hiOdo.count);
+                        blockMax = SignVec{};
+                        curHi = hi;
+                    }
+                    blockMax = maxVec(blockMax, hi == 0 ? lowPlain[lo] : lowPadded[lo]);
+                    pending = true;
+                }
+            }
+            if (pending) signs = maxVec(signs, hiVec + blockMax);
+            partial[t] = signs;
+        });
+    }
+    for (auto& th : pool) th.join();
+
+    SignCounts signs_needed{};
+    for (const auto& p : partial) {
+        for (int d = 0; d <= 8; d++) signs_needed[d] = std::max<int>(signs_needed[d], p[d]);
+    }
+    return signs_needed;
+}
+
+// Signs needed over every reachable score, via the digit DP
+inline SignCounts solve(const ScoreValuesInput& input, ScoreValuesWorkspace& workspace) {
+    return dpSigns(input.m, input.increments, workspace);
+}
+
+inline SignCounts solve(const ScoreValuesInput& input) {
+    ScoreValuesWorkspace workspace;
+    return solve(input, workspace);
+}
+
+// Same answer from the explicit bitset; input.m must fit in memory as bits
+inline SignCounts solveBitset(const ScoreValuesInput& input, int threads) {
+    return bitsetSigns(ReachBitset(input.m, input.increments), threads);
+}
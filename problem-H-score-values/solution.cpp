@@ -1,76 +1,49 @@
-/*
- * Problem H: Score Values
- * 
- * This solution uses BFS to find all reachable scores with the capping mechanics,
- * then computes the maximum digit frequencies across all reachable scores.
- * 
- * Key insight: Scores start at 0 and can be incremented by fixed amounts,
- * but are capped at the maximum value m if an increment would exceed it.
- */
-
 #include <bits/stdc++.h>
+#include "../common/fast_input.h"
+#include "score_values.h"
 using namespace std;
 
-int main() {
+// Reads m and the increments, solves with score_values.h and prints the signs
+
+int main(int argc, char* argv[]) {
     ios::sync_with_stdio(false);
     cin.tie(nullptr);
+    FastInput in;
+
+    // --bitset[=THREADS]: materialize reachability as a packed bitset and scan
+    // every reachable score (m up to ~10^10); mainly a cross-check for the
+    // digit DP and a fast path for mid-range m
+    int bitsetThreads = 0;
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (arg == "--bitset") {
+            bitsetThreads = max(1u, thread::hardware_concurrency());
+        } else if (arg.rfind("--bitset=", 0) == 0) {
+            bitsetThreads = max(1, atoi(arg.c_str() + 9));
+        }
+    }
+    const long long BITSET_MAX_M = 10000000000LL;  // 1.25 GB of bits
 
     // Read input
-    long long m;  // Maximum score
+    ScoreValuesInput input;
     int n;        // Number of increment types
-    cin >> m >> n;
-    
-    vector<int> increments(n);
+    in >> input.m >> n;
+
+    input.increments.resize(n);
     for (int i = 0; i < n; i++) {
-        cin >> increments[i];
+        in >> input.increments[i];
     }
 
-    // Find all reachable scores using BFS
-    // Game mechanics: start at 0, can add any increment, cap at m
-    set<long long> reachable;
-    queue<long long> q;
-    q.push(0);
-    reachable.insert(0);
-    
-    while (!q.empty()) {
-        long long current = q.front();
-        q.pop();
-        
-        for (int p : increments) {
-            // Calculate next score with capping at maximum
-            long long next = min(current + (long long)p, m);
-            if (reachable.find(next) == reachable.end()) {
-                reachable.insert(next);
-                q.push(next);
-            }
+    SignCounts signs_needed{};
+    if (bitsetThreads > 0 && input.m <= BITSET_MAX_M) {
+        signs_needed = solveBitset(input, bitsetThreads);
+    } else {
+        if (bitsetThreads > 0) {
+            cerr << "m too large for --bitset, using the digit DP\n";
         }
+        signs_needed = solve(input);
     }
-    
-    // Find the maximum count needed for each digit
-    // Important: digit 6 can be flipped upside-down to show 9
-    vector<int> signs_needed(9, 0);
-    
-    for (long long score : reachable) {
-        string s = to_string(score);
-        vector<int> digit_count(10, 0);
-        
-        // Count each digit in this score
-        for (char c : s) {
-            digit_count[c - '0']++;
-        }
-        
-        // Update maximum for digits 0-5, 7-8
-        for (int d = 0; d <= 8; d++) {
-            if (d != 6) {
-                signs_needed[d] = max(signs_needed[d], digit_count[d]);
-            }
-        }
-        
-        // For digit 6: need enough to cover both 6s and 9s
-        // (since a 6 sign can be flipped to show 9)
-        signs_needed[6] = max(signs_needed[6], digit_count[6] + digit_count[9]);
-    }
-    
+
     // Output the results
     // Format: digit count (one pair per line)
     // Only output digits with non-zero counts
@@ -79,6 +52,6 @@ int main() {
             cout << d << ' ' << signs_needed[d] << '\n';
         }
     }
-    
+
     return 0;
-}
\ No newline at end of file
+}
@@ -7,6 +7,12 @@ if [ ! -f solution ]; then
     g++ -O2 -std=c++17 -Wall solution.cpp -o solution
 fi
 
+# Compile simulator if not already compiled
+if [ ! -f simulator ]; then
+    echo "Compiling simulator..."
+    g++ -O2 -std=c++17 -Wall -pthread simulator.cpp -o simulator
+fi
+
 # Compile test judge if not already compiled
 if [ ! -f test_judge ]; then
     echo "Compiling test judge..."
@@ -34,8 +40,9 @@ run_case() {
     ./solution <"$j2s" >"$s2j" 2>"$tmp/sol.err" &
     local sol_pid=$!
     
-    # Run judge reading from s2j, writing to j2s
-    ./test_judge "$n" "$initial" <"$s2j" >"$j2s" 2>"$tmp/judge.log" || true
+    # Run judge writing to j2s, reading from s2j (open j2s first: the
+    # solution is already blocked opening it, so the reverse order deadlocks)
+    ./test_judge "$n" "$initial" >"$j2s" <"$s2j" 2>"$tmp/judge.log" || true
     
     # Wait for solution to finish
     wait "$sol_pid" 2>/dev/null || true
@@ -61,4 +68,21 @@ run_case 4 0123 "Test 3: n=4, all different"
 run_case 5 00111 "Test 4: n=5, partial alignment"
 run_case 10 0123456789 "Test 5: n=10, worst case"
 
+# In-process Monte-Carlo runs for sizes the judge cannot express
+echo "Running simulator benchmarks..."
+echo
+# The simulator exits 2 when any game is left unsolved
+sim_failed=0
+for n in 10 50; do
+    if ! ./simulator --n="$n" --games=2000 --worst=1; then
+        echo "Simulator failed for n=$n"
+        sim_failed=1
+    fi
+    echo
+done
+
+if [ "$sim_failed" -ne 0 ]; then
+    echo "Some simulator runs failed."
+    exit 1
+fi
 echo "All tests completed."
\ No newline at end of file
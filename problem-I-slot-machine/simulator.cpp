@@ -0,0 +1,256 @@
+#include <bits/stdc++.h>
+#include "slot_strategy.h"
+using namespace std;
+
+// In-process slot machine simulator and Monte-Carlo strategy benchmark
+//
+// Usage: ./simulator [--n=N] [--games=G] [--threads=T] [--seed=S]
+//                    [--mode=random|adversarial|mixed] [--worst=W]
+//                    [--strategy=inference|scanning]
+//
+// Runs G games of the strategy against simulated machines with n wheels
+// (any n >= 2, no limit on symbol count), spread over T threads, and reports
+// the distribution of action counts, the failure rate, the worst initial
+// configurations and the time per game. Every game is reproducible from
+// (seed, game index).
+
+// A machine whose state is known, answering k in O(1) per rotation
+class SimulatedMachine : public SlotMachine {
+public:
+    SimulatedMachine(int n, const vector<int>& initial) : n(n), wheels(initial), count(n, 0) {
+        for (int w : wheels) {
+            if (count[w]++ == 0) distinct++;
+        }
+    }
+
+    int rotate(int wheel, int delta) override {
+        actions++;
+        if (wheel < 1 || wheel > n) {
+            invalid = true;
+            return distinct;
+        }
+        int& w = wheels[wheel - 1];
+        if (--count[w] == 0) distinct--;
+        w = ((w + delta) % n + n) % n;
+        if (count[w]++ == 0) distinct++;
+        return distinct;
+    }
+
+    int k() const { return distinct; }
+
+    int n;
+    vector<int> wheels;
+    vector<int> count;     // wheels showing each symbol
+    int distinct = 0;
+    bool invalid = false;  // strategy addressed a nonexistent wheel
+};
+
+enum class Mode { Random, Adversarial, Mixed };
+
+const int ADVERSARIAL_FAMILIES = 6;
+
+const char* familyName(int family) {
+    static const char* names[] = {
+        "permutation", "identity", "one-outlier", "two-clusters",
+        "unique-reference", "stride",
+    };
+    return family < 0 ? "random" : names[family];
+}
+
+// Structured configurations that stress scanning strategies
+vector<int> adversarialConfig(int n, int family, mt19937_64& rng) {
+    vector<int> c(n);
+    switch (family) {
+        case 0:  // all distinct, random order
+            iota(c.begin(), c.end(), 0);
+            shuffle(c.begin(), c.end(), rng);
+            break;
+        case 1:  // all distinct, in order
+            iota(c.begin(), c.end(), 0);
+            break;
+        case 2: {  // everything aligned except one wheel
+            int base = rng() % n;
+            fill(c.begin(), c.end(), base);
+            c[rng() % n] = (base + 1 + rng() % (n - 1)) % n;
+            break;
+        }
+        case 3: {  // two symbols, random split
+            int a = rng() % n, b = (a + 1 + rng() % (n - 1)) % n;
+            for (int& x : c) x = (rng() & 1) ? a : b;
+            c[0] = a;
+            c[1] = b;
+            break;
+        }
+        case 4: {  // the reference wheel shows a symbol no other wheel has
+            c[0] = rng() % n;
+            for (int i = 1; i < n; i++) c[i] = (c[0] + 1 + rng() % (n - 1)) % n;
+            break;
+        }
+        default: {  // arithmetic progression with a random stride
+            int step = 1 + rng() % (n - 1), off = rng() % n;
+            for (int i = 0; i < n; i++) c[i] = (off + (long long)i * step) % n;
+            break;
+        }
+    }
+    return c;
+}
+
+// Initial configuration of one game; k = 1 starts are re-drawn
+vector<int> gameConfig(int n, Mode mode, uint64_t seed, long long game, int& family) {
+    mt19937_64 rng(seed ^ (0x9E3779B97F4A7C15ULL * (uint64_t)(game + 1)));
+    bool adversarial = mode == Mode::Adversarial || (mode == Mode::Mixed && (game & 1));
+    family = adversarial ? (int)(game % ADVERSARIAL_FAMILIES) : -1;
+    while (true) {
+        vector<int> c;
+        if (adversarial) {
+            c = adversarialConfig(n, family, rng);
+        } else {
+            c.resize(n);
+            for (int& x : c) x = rng() % n;
+        }
+        if (any_of(c.begin(), c.end(), [&](int x) { return x != c[0]; })) return c;
+    }
+}
+
+struct GameResult {
+    int actions;
+    bool solved;
+};
+
+enum class Strategy { Inference, Scanning };
+
+GameResult playGame(int n, const vector<int>& config, Strategy strategy) {
+    SimulatedMachine machine(n, config);
+    if (strategy == Strategy::Inference) solve_by_inference(machine, n, machine.k());
+    else solve_by_scanning(machine, n, machine.k());
+    bool solved = machine.k() == 1 && machine.actions <= MAX_ACTIONS && !machine.invalid;
+    return {machine.actions, solved};
+}
+
+int main(int argc, char* argv[]) {
+    int n = 50;
+    long long games = 100000;
+    int threads = max(1u, thread::hardware_concurrency());
+    uint64_t seed = 1;
+    Mode mode = Mode::Mixed;
+    int worstShown = 5;
+    Strategy strategy = Strategy::Inference;
+
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        auto value = [&](const char* key) -> const char* {
+            size_t len = strlen(key);
+            return arg.compare(0, len, key) == 0 ? arg.c_str() + len : nullptr;
+        };
+        if (const char* v = value("--n=")) n = atoi(v);
+        else if (const char* v = value("--games=")) games = atoll(v);
+        else if (const char* v = value("--threads=")) threads = max(1, atoi(v));
+        else if (const char* v = value("--seed=")) seed = strtoull(v, nullptr, 10);
+        else if (const char* v = value("--worst=")) worstShown = max(0, atoi(v));
+        else if (const char* v = value("--mode=")) {
+            string m = v;
+            if (m == "random") mode = Mode::Random;
+            else if (m == "adversarial") mode = Mode::Adversarial;
+            else if (m == "mixed") mode = Mode::Mixed;
+            else {
+                cerr << "Unknown mode: " << m << "\n";
+                return 1;
+            }
+        } else if (const char* v = value("--strategy=")) {
+            string st = v;
+            if (st == "inference") strategy = Strategy::Inference;
+            else if (st == "scanning") strategy = Strategy::Scanning;
+            else {
+                cerr << "Unknown strategy: " << st << "\n";
+                return 1;
+            }
+        } else {
+            cerr << "Usage: " << argv[0] << " [--n=N] [--games=G] [--threads=T] [--seed=S]"
+                 << " [--mode=random|adversarial|mixed] [--worst=W]"
+                 << " [--strategy=inference|scanning]\n";
+            return 1;
+        }
+    }
+    if (n < 2 || games < 1) {
+        cerr << "Error: need n >= 2 and at least one game\n";
+        return 1;
+    }
+
+    vector<int> actions(games);
+    vector<char> solved(games);
+    atomic<long long> nextGame{0};
+    const long long CHUNK = 256;
+
+    auto start = chrono::steady_clock::now();
+    vector<thread> pool;
+    for (int t = 0; t < threads; t++) {
+        pool.emplace_back([&]() {
+            int family;
+            while (true) {
+                long long begin = nextGame.fetch_add(CHUNK);
+                if (begin >= games) break;
+                long long end = min(games, begin + CHUNK);
+                for (long long g = begin; g < end; g++) {
+                    GameResult r = playGame(n, gameConfig(n, mode, seed, g, family), strategy);
+                    actions[g] = r.actions;
+                    solved[g] = r.solved;
+                }
+            }
+        });
+    }
+    for (auto& th : pool) th.join();
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    // Distribution of action counts
+    vector<int> sorted = actions;
+    sort(sorted.begin(), sorted.end());
+    auto pct = [&](double p) { return sorted[min<long long>(games - 1, (long long)(p * games))]; };
+    long long totalActions = accumulate(actions.begin(), actions.end(), 0LL);
+    long long failures = count(solved.begin(), solved.end(), 0);
+
+    cout << fixed << setprecision(2);
+    cout << "Slot machine benchmark: n=" << n << ", games=" << games << ", threads=" << threads
+         << ", seed=" << seed << ", strategy="
+         << (strategy == Strategy::Inference ? "inference" : "scanning") << "\n";
+    cout << "Solved:   " << (games - failures) << " / " << games
+         << " (" << 100.0 * (games - failures) / games << "%)\n";
+    cout << "Actions:  mean " << (double)totalActions / games << ", min " << sorted.front()
+         << ", p50 " << pct(0.50) << ", p90 " << pct(0.90) << ", p99 " << pct(0.99)
+         << ", p99.9 " << pct(0.999) << ", max " << sorted.back() << "\n";
+
+    // Histogram over 10 equal-width buckets
+    int lo = sorted.front(), hi = sorted.back();
+    int width = max(1, (hi - lo + 10) / 10);
+    cout << "Histogram:\n";
+    for (int b = lo; b <= hi; b += width) {
+        long long cnt = upper_bound(sorted.begin(), sorted.end(), b + width - 1)
+                      - lower_bound(sorted.begin(), sorted.end(), b);
+        cout << "  [" << setw(5) << b << ", " << setw(5) << (b + width - 1) << "] "
+             << setw(10) << cnt << "\n";
+    }
+
+    cout << "Time:     " << seconds << " s total, "
+         << setprecision(3) << 1e6 * seconds * threads / games << " us CPU per game, "
+         << 1e9 * seconds * threads / max(1LL, totalActions) << " ns CPU per action\n";
+
+    // Worst games: failures first, then most actions
+    vector<long long> order(games);
+    iota(order.begin(), order.end(), 0);
+    int shown = min<long long>(worstShown, games);
+    partial_sort(order.begin(), order.begin() + shown, order.end(), [&](long long a, long long b) {
+        if (solved[a] != solved[b]) return !solved[a];
+        return actions[a] > actions[b];
+    });
+    if (shown > 0) cout << "Worst games:\n";
+    for (int i = 0; i < shown; i++) {
+        long long g = order[i];
+        int family;
+        vector<int> config = gameConfig(n, mode, seed, g, family);
+        cout << "  game " << g << " (" << familyName(family) << "): " << actions[g] << " actions, "
+             << (solved[g] ? "solved" : "FAILED") << ", config";
+        for (int x : config) cout << ' ' << x;
+        cout << "\n";
+    }
+
+    return failures > 0 ? 2 : 0;
+}
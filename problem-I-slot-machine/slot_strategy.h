@@ -0,0 +1,445 @@
+/*
+ * Slot Machine strategies behind a query interface
+ *
+ * A strategy only ever rotates a wheel and observes k, the number of distinct
+ * symbols visible. SlotMachine captures exactly that, so the same strategy
+ * code runs against the interactive judge (solution.cpp) and against the
+ * in-process simulator (simulator.cpp).
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <climits>
+#include <ostream>
+#include <utility>
+#include <vector>
+
+const int MAX_ACTIONS = 10000;
+
+// What a strategy can do with the machine
+class SlotMachine {
+public:
+    virtual ~SlotMachine() = default;
+
+    // Rotate wheel (1-based) by delta positions and return the new k
+    virtual int rotate(int wheel, int delta) = 0;
+
+    int actions = 0;               // rotations issued so far
+    std::ostream* log = nullptr;   // progress messages, or nullptr for none
+};
+
+// Find the optimal position for a wheel by scanning all possibilities
+inline std::pair<int, int> find_best_position(SlotMachine& machine, int wheel, int n, int current_k) {
+    // Track the best position and its k value
+    int best_k = current_k;
+    int best_pos = 0;  // Position 0 is where we started
+    int last_k = current_k;
+
+    // Scan positions 1 to n-1 by rotating +1 each time
+    for (int pos = 1; pos < n; pos++) {
+        last_k = machine.rotate(wheel, 1);
+
+        if (last_k < best_k) {
+            best_k = last_k;
+            best_pos = pos;
+        }
+
+        // Early termination if we achieve the goal
+        if (last_k == 1) {
+            return {pos, last_k};
+        }
+    }
+
+    // After scanning, we're at position n-1
+    // Need to move to best_pos
+
+    if (best_pos == n - 1) {
+        // We're already at the best position (position n-1)
+        // No need to move, return the current k value
+        return {best_pos, last_k};
+    }
+
+    // Calculate how many +1 rotations needed to reach best_pos from position n-1
+    // We need to go from n-1 to best_pos, wrapping around at n
+    int steps_needed = (best_pos - (n - 1) + n) % n;
+
+    if (steps_needed == 0) {
+        // Already at best position (shouldn't happen as we handled best_pos == n-1)
+        return {best_pos, last_k};
+    }
+
+    // Move to best position with multiple +1 rotations
+    // (The problem allows arbitrary delta in one command, but using +1 for safety)
+    int final_k = last_k;
+    for (int i = 0; i < steps_needed; i++) {
+        final_k = machine.rotate(wheel, 1);
+        if (final_k == 1) {
+            // Early termination if we hit the goal during repositioning
+            return {(n - 1 + i + 1) % n, final_k};
+        }
+    }
+
+    return {best_pos, final_k};
+}
+
+// Alternative implementation using single large rotation (if allowed by protocol)
+inline std::pair<int, int> find_best_position_optimized(SlotMachine& machine, int wheel, int n, int current_k) {
+    // Track the best position and its k value
+    int best_k = current_k;
+    int best_pos = 0;  // Position 0 is where we started
+    int last_k = current_k;
+
+    // Scan positions 1 to n-1 by rotating +1 each time
+    for (int pos = 1; pos < n; pos++) {
+        last_k = machine.rotate(wheel, 1);
+
+        if (last_k < best_k) {
+            best_k = last_k;
+            best_pos = pos;
+        }
+
+        // Early termination if we achieve the goal
+        if (last_k == 1) {
+            return {pos, last_k};
+        }
+    }
+
+    // After scanning, we're at position n-1
+
+    if (best_pos == n - 1) {
+        // Already at the best position
+        return {best_pos, last_k};
+    }
+
+    // Calculate rotation needed from n-1 to best_pos
+    // This uses a single rotation command with larger delta
+    int delta = (best_pos + 1) % n;  // +1 because we need one more to complete the circle
+
+    if (delta == 0) {
+        // Position 0 is best, need to rotate by 1
+        delta = 1;
+    }
+
+    int final_k = machine.rotate(wheel, delta);
+    return {best_pos, final_k};
+}
+
+// Wheel-by-wheel scanning passes (wheel 1 is the fixed reference).
+// Returns the final k.
+inline int solve_by_scanning(SlotMachine& machine, int n, int k) {
+    std::ostream* log = machine.log;
+
+    // Already solved (shouldn't happen according to problem)
+    if (k == 1) {
+        if (log) *log << "Already solved!" << std::endl;
+        return k;
+    }
+
+    int pass = 0;
+    const int MAX_PASSES = 5;  // Usually 2-3 passes suffice
+
+    while (k > 1 && pass < MAX_PASSES && machine.actions < MAX_ACTIONS - 2*n) {
+        pass++;
+        if (log) *log << "\n=== Pass " << pass << " ===" << std::endl;
+
+        bool improved = false;
+        int initial_k = k;
+
+        // Optimize each wheel (except wheel 1 which is our reference)
+        for (int wheel = 2; wheel <= n && k > 1; wheel++) {
+            if (log) *log << "Optimizing wheel " << wheel << "..." << std::endl;
+
+            // Use the optimized version (single large rotation)
+            // Comment out next line and uncomment the one after to use multiple +1 rotations
+            auto [best_pos, new_k] = find_best_position_optimized(machine, wheel, n, k);
+            // auto [best_pos, new_k] = find_best_position(machine, wheel, n, k);
+
+            if (new_k < k) {
+                improved = true;
+                if (log) *log << "Wheel " << wheel << " improved k from " << k
+                              << " to " << new_k << " at position " << best_pos << std::endl;
+            }
+
+            k = new_k;
+
+            // Goal achieved
+            if (k == 1) {
+                return k;
+            }
+
+            // Check action limit
+            if (machine.actions >= MAX_ACTIONS - 2*n) {
+                if (log) *log << "Approaching action limit, stopping..." << std::endl;
+                break;
+            }
+        }
+
+        if (log) *log << "Pass " << pass << " complete: k reduced from "
+                      << initial_k << " to " << k << std::endl;
+
+        // Stop if no improvement in this pass
+        if (!improved) {
+            if (log) *log << "No improvement in pass " << pass << ", stopping" << std::endl;
+            break;
+        }
+    }
+
+    return k;
+}
+
+/*
+ * Offset inference strategy
+ *
+ * Positions are tracked in a fixed frame: wheel 1 starts at 0. Let U be the
+ * set of occupied symbols. If only wheel i (at unknown x) moves, to x + t,
+ * the machine answers
+ *     k = |O| + [x + t not in O],   O = symbols shown by the other wheels,
+ * with O = U \ {x} if wheel i is alone at x and O = U otherwise. So with U
+ * known, each large-delta rotation of wheel i is a membership test that
+ * splits the remaining hypotheses (x, alone) for wheel i.
+ *
+ * 1. Scan wheel 1 through all n symbols (n-1 actions): k is minimal exactly
+ *    on the symbols occupied by the other wheels, which gives U.
+ * 2. For each other wheel, pick the rotation whose three possible answers
+ *    split the hypotheses most evenly, until its position is known, then
+ *    rotate it onto wheel 1's symbol g. A wheel that was alone frees its old
+ *    symbol, so later wheels get more informative probes.
+ * 3. Two positions x, x' can only be confused when U is periodic with period
+ *    x' - x. That is broken before probing by parking a known wheel (an
+ *    already merged one, or wheel 1 itself) on another symbol.
+ *
+ * Cost: n-1 scan actions, about log2(2n) probes per wheel once a few symbols
+ * are free (up to n / #free while U is nearly full), and one merge each.
+ */
+class InferenceSolver {
+public:
+    InferenceSolver(SlotMachine& machine, int n, int k) : machine(machine), n(n), k(k) {}
+
+    int solve() {
+        if (k == 1 || n < 2) return k;
+        if (!scanReference()) return k;
+
+        for (int wheel = 2; wheel <= n && k > 1; wheel++) {
+            if (!placeWheel(wheel)) break;
+        }
+        if (machine.log) {
+            *machine.log << "Inference strategy finished with k=" << k << " after "
+                         << machine.actions << " actions" << std::endl;
+        }
+        return k;
+    }
+
+private:
+    struct Hypothesis {
+        int x;
+        bool alone;
+    };
+
+    SlotMachine& machine;
+    int n, k;
+    int g = 0;                               // symbol shown by wheel 1
+    bool othersAtG = false;                  // another wheel shares wheel 1's symbol
+    std::vector<char> inU;                   // occupied symbols
+    int sizeU = 0;
+    std::vector<std::vector<char>> cand;     // possible symbols per unplaced wheel
+    std::vector<int> merged;                 // wheels (besides 1) known to be at g
+    int parkedWheel = 0;                     // merged wheel moved off g to break symmetry
+
+    int mod(int v) const { return ((v % n) + n) % n; }
+
+    bool budgetLeft() const { return machine.actions < MAX_ACTIONS; }
+
+    // Rotate and record the answer; false once solved or out of actions
+    bool rotate(int wheel, int delta) {
+        delta = mod(delta);
+        if (delta != 0) k = machine.rotate(wheel, delta);
+        return k > 1 && budgetLeft();
+    }
+
+    void setU(int v, bool occupied) {
+        if (inU[v] != occupied) {
+            inU[v] = occupied;
+            sizeU += occupied ? 1 : -1;
+        }
+    }
+
+    bool scanReference() {
+        std::vector<int> seen(n);
+        seen[0] = k;
+        for (int t = 1; t < n; t++) {
+            if (!rotate(1, 1)) return false;
+            seen[t] = k;
+        }
+        // k_t = |O| + [t not in O]: the minimum marks the occupied symbols
+        int low = *std::min_element(seen.begin(), seen.end());
+        inU.assign(n, 0);
+        for (int t = 0; t < n; t++) {
+            if (seen[t] == low) setU(t, true);
+        }
+        std::vector<char> others = inU;
+        g = n - 1;
+        othersAtG = inU[g];
+        setU(g, true);
+        cand.assign(n + 1, others);
+        return true;
+    }
+
+    // Answer for hypothesis h after moving the wheel to displacement t
+    int outcome(const Hypothesis& h, int t) const {
+        int base = sizeU - (h.alone ? 1 : 0);
+        if (t == 0) return base + (h.alone ? 1 : 0);
+        return base + (inU[mod(h.x + t)] ? 0 : 1);
+    }
+
+    // Rotation (as a displacement from x) that best splits hyps; returns the
+    // size of the largest answer class through worst
+    int bestProbe(const std::vector<Hypothesis>& hyps, int tCur, int& worst) const {
+        int best = -1;
+        worst = INT_MAX;
+        for (int t = 0; t < n; t++) {
+            if (t == tCur) continue;
+            int cnt[3] = {0, 0, 0};
+            for (const auto& h : hyps) cnt[outcome(h, t) - sizeU + 1]++;
+            int w = std::max({cnt[0], cnt[1], cnt[2]});
+            if (w < worst) {
+                worst = w;
+                best = t;
+            }
+        }
+        return best;
+    }
+
+    // Number of distinct probe signatures among candidate symbols xs
+    int signatureClasses(const std::vector<int>& xs) const {
+        std::vector<std::vector<char>> sigs;
+        for (int x : xs) {
+            std::vector<char> sig(n);
+            for (int t = 0; t < n; t++) sig[t] = inU[mod(x + t)];
+            sigs.push_back(sig);
+        }
+        std::sort(sigs.begin(), sigs.end());
+        return std::unique(sigs.begin(), sigs.end()) - sigs.begin();
+    }
+
+    std::vector<int> candidates(int wheel, int parked) const {
+        std::vector<int> xs;
+        for (int x = 0; x < n; x++) {
+            if (cand[wheel][x] && inU[x] && x != parked) xs.push_back(x);
+        }
+        return xs;
+    }
+
+    // Park a known wheel so that U stops being periodic over the candidates.
+    // Returns the symbol a merged wheel was parked on (to undo later) or -1.
+    int breakSymmetry(int wheel, bool& ok) {
+        ok = true;
+        std::vector<int> xs = candidates(wheel, -1);
+        if ((int)xs.size() <= 1 || signatureClasses(xs) == (int)xs.size()) return -1;
+
+        if (!merged.empty()) {
+            // A merged wheel leaves g (still held by wheel 1) for a free symbol
+            int bestF = -1, bestClasses = 0;
+            for (int f = 0; f < n; f++) {
+                if (inU[f]) continue;
+                setU(f, true);
+                int c = signatureClasses(xs);
+                setU(f, false);
+                if (c > bestClasses) {
+                    bestClasses = c;
+                    bestF = f;
+                }
+            }
+            if (bestF < 0) return -1;
+            parkedWheel = merged.back();
+            ok = rotate(parkedWheel, bestF - g);
+            setU(bestF, true);
+            return bestF;
+        }
+
+        // Nothing merged yet: move wheel 1 itself, and g with it
+        bool alone = !othersAtG;
+        int bestF = -1, bestClasses = 0;
+        for (int f = 0; f < n; f++) {
+            if (f == g) continue;
+            std::vector<char> saved = inU;
+            int savedSize = sizeU;
+            if (alone) setU(g, false);
+            setU(f, true);
+            int c = signatureClasses(candidates(wheel, -1));
+            inU = saved;
+            sizeU = savedSize;
+            if (c > bestClasses) {
+                bestClasses = c;
+                bestF = f;
+            }
+        }
+        othersAtG = inU[bestF];
+        ok = rotate(1, bestF - g);
+        if (alone) {
+            setU(g, false);
+            for (auto& c : cand) c[g] = 0;
+        }
+        setU(bestF, true);
+        g = bestF;
+        return -1;
+    }
+
+    bool placeWheel(int wheel) {
+        bool ok;
+        int parked = breakSymmetry(wheel, ok);
+        if (!ok) return false;
+
+        std::vector<Hypothesis> hyps;
+        for (int x : candidates(wheel, parked)) {
+            hyps.push_back({x, false});
+            if (x != g) hyps.push_back({x, true});  // wheel 1 is at g
+        }
+        if (hyps.empty()) return true;  // inconsistent knowledge; leave it
+
+        // Probe until the position is known
+        int tCur = 0;
+        auto distinctX = [&]() {
+            for (const auto& h : hyps) if (h.x != hyps[0].x) return true;
+            return false;
+        };
+        while (distinctX()) {
+            int worst;
+            int t = bestProbe(hyps, tCur, worst);
+            if (t < 0 || worst == (int)hyps.size()) break;  // unresolvable, guess
+            if (!rotate(wheel, t - tCur)) return false;
+            tCur = t;
+            std::vector<Hypothesis> next;
+            for (const auto& h : hyps) if (outcome(h, t) == k) next.push_back(h);
+            if (next.empty()) break;  // answers contradict the model; guess
+            hyps.swap(next);
+        }
+
+        // Merge onto g; the answer (|U| - alone) tells whether it was alone
+        int x = hyps[0].x;
+        bool alone = hyps[0].alone;
+        if (mod(x + tCur) != g) {
+            int before = sizeU;
+            if (!rotate(wheel, g - x - tCur)) return false;
+            alone = before - k == 1;
+        }
+        if (alone && x != g) {
+            setU(x, false);
+            for (auto& c : cand) c[x] = 0;
+        }
+        merged.push_back(wheel);
+        othersAtG = true;
+
+        if (parked >= 0) {
+            if (!rotate(parkedWheel, g - parked)) return false;
+            setU(parked, false);
+        }
+        return true;
+    }
+};
+
+// Offset inference with large-delta probes (see InferenceSolver). Returns the final k.
+inline int solve_by_inference(SlotMachine& machine, int n, int k) {
+    InferenceSolver solver(machine, n, k);
+    return solver.solve();
+}
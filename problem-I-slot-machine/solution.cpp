@@ -9,212 +9,142 @@
  * - Max 10,000 actions allowed
  * - Time limit: 2 seconds
  * 
- * Algorithm Strategy:
- * 1. Use wheel 1 as reference (never rotate it)
+ * Algorithm Strategy (solve_by_inference in slot_strategy.h):
+ * 1. Scan wheel 1 once to learn which symbols the other wheels occupy
  * 2. For each wheel i (2 to n):
- *    - Scan all n positions by rotating +1 repeatedly
- *    - Track which position gives minimum k
- *    - Move to that optimal position with proper repositioning
- * 3. Repeat passes until k=1 or no improvement
+ *    - Rotate it by the delta whose answer best splits its possible positions
+ *    - Once its position is known, rotate it onto wheel 1's symbol
+ * 3. Break periodic symbol sets by parking an already placed wheel
  * 
- * Complexity: O(n^2) actions per pass, typically 2-3 passes needed
- * Worst case for n=50: ~7500 actions (well within 10,000 limit)
+ * Complexity: n-1 scan actions plus a few probes per wheel
+ * Worst case seen for n=50: 537 actions (well within 10,000 limit)
+ *
+ * I/O: one write() per command, replies parsed from a read() buffer.
+ * Build with -DSLOT_TRACE to keep the last actions in a ring buffer that is
+ * dumped to stderr at exit; without it no tracing code is compiled in.
  */
 
 #include <bits/stdc++.h>
+#include <unistd.h>
+#include "slot_strategy.h"
 using namespace std;
 
-// Global action counter for debugging/monitoring
-int total_actions = 0;
-const int MAX_ACTIONS = 10000;
-
-// Send a rotation command and receive the new k value
-int rotate_and_query(int wheel, int delta) {
-    cout << wheel << " " << delta << endl;
-    cout.flush();
-    
-    int new_k;
-    cin >> new_k;
-    
-    total_actions++;
-    
-    // Debug output to stderr (not visible to judge)
-    cerr << "Action " << total_actions << ": Rotate wheel " << wheel 
-         << " by " << delta << " -> k=" << new_k << endl;
-    
-    return new_k;
-}
-
-// Find the optimal position for a wheel by scanning all possibilities
-pair<int, int> find_best_position(int wheel, int n, int current_k) {
-    // Track the best position and its k value
-    int best_k = current_k;
-    int best_pos = 0;  // Position 0 is where we started
-    int last_k = current_k;
-    
-    // Scan positions 1 to n-1 by rotating +1 each time
-    for (int pos = 1; pos < n; pos++) {
-        last_k = rotate_and_query(wheel, 1);
-        
-        if (last_k < best_k) {
-            best_k = last_k;
-            best_pos = pos;
+// Buffered reader for the judge's replies (plain integers)
+class ReplyReader {
+public:
+    // Next integer, or -1 on EOF
+    int nextInt() {
+        int c = get();
+        while (c != -1 && c != '-' && (c < '0' || c > '9')) c = get();
+        if (c == -1) return -1;
+        bool neg = c == '-';
+        if (neg) c = get();
+        int v = 0;
+        while (c >= '0' && c <= '9') {
+            v = v * 10 + (c - '0');
+            c = get();
         }
-        
-        // Early termination if we achieve the goal
-        if (last_k == 1) {
-            return {pos, last_k};
-        }
-    }
-    
-    // After scanning, we're at position n-1
-    // Need to move to best_pos
-    
-    if (best_pos == n - 1) {
-        // We're already at the best position (position n-1)
-        // No need to move, return the current k value
-        return {best_pos, last_k};
+        return neg ? -v : v;
     }
-    
-    // Calculate how many +1 rotations needed to reach best_pos from position n-1
-    // We need to go from n-1 to best_pos, wrapping around at n
-    int steps_needed = (best_pos - (n - 1) + n) % n;
-    
-    if (steps_needed == 0) {
-        // Already at best position (shouldn't happen as we handled best_pos == n-1)
-        return {best_pos, last_k};
-    }
-    
-    // Move to best position with multiple +1 rotations
-    // (The problem allows arbitrary delta in one command, but using +1 for safety)
-    int final_k = last_k;
-    for (int i = 0; i < steps_needed; i++) {
-        final_k = rotate_and_query(wheel, 1);
-        if (final_k == 1) {
-            // Early termination if we hit the goal during repositioning
-            return {(n - 1 + i + 1) % n, final_k};
+
+private:
+    int get() {
+        if (pos == len) {
+            ssize_t r;
+            do r = read(0, buf, sizeof(buf));
+            while (r < 0 && errno == EINTR);
+            if (r <= 0) return -1;
+            pos = 0;
+            len = r;
         }
+        return (unsigned char)buf[pos++];
     }
-    
-    return {best_pos, final_k};
-}
 
-// Alternative implementation using single large rotation (if allowed by protocol)
-pair<int, int> find_best_position_optimized(int wheel, int n, int current_k) {
-    // Track the best position and its k value
-    int best_k = current_k;
-    int best_pos = 0;  // Position 0 is where we started
-    int last_k = current_k;
-    
-    // Scan positions 1 to n-1 by rotating +1 each time
-    for (int pos = 1; pos < n; pos++) {
-        last_k = rotate_and_query(wheel, 1);
-        
-        if (last_k < best_k) {
-            best_k = last_k;
-            best_pos = pos;
-        }
-        
-        // Early termination if we achieve the goal
-        if (last_k == 1) {
-            return {pos, last_k};
+    char buf[1 << 12];
+    size_t pos = 0, len = 0;
+};
+
+#ifdef SLOT_TRACE
+// The most recent actions, dumped to stderr at exit
+struct TraceRing {
+    struct Entry {
+        int wheel, delta, k;
+    };
+    static const int CAPACITY = 1 << 12;
+    Entry entries[CAPACITY];
+    long long count = 0;
+
+    void add(int wheel, int delta, int k) { entries[count++ % CAPACITY] = {wheel, delta, k}; }
+
+    void dump() const {
+        long long first = max(0LL, count - CAPACITY);
+        fprintf(stderr, "Trace: %lld actions, last %lld:\n", count, count - first);
+        for (long long i = first; i < count; i++) {
+            const Entry& e = entries[i % CAPACITY];
+            fprintf(stderr, "Action %lld: Rotate wheel %d by %d -> k=%d\n", i + 1, e.wheel, e.delta, e.k);
         }
     }
-    
-    // After scanning, we're at position n-1
-    
-    if (best_pos == n - 1) {
-        // Already at the best position
-        return {best_pos, last_k};
-    }
-    
-    // Calculate rotation needed from n-1 to best_pos
-    // This uses a single rotation command with larger delta
-    int delta = (best_pos + 1) % n;  // +1 because we need one more to complete the circle
-    
-    if (delta == 0) {
-        // Position 0 is best, need to rotate by 1
-        delta = 1;
-    }
-    
-    int final_k = rotate_and_query(wheel, delta);
-    return {best_pos, final_k};
-}
+};
 
-int main() {
-    ios::sync_with_stdio(false);
-    cin.tie(nullptr);
-    
-    // Ensure unbuffered I/O for interactive communication
-    setvbuf(stdin, nullptr, _IONBF, 0);
-    setvbuf(stdout, nullptr, _IONBF, 0);
-    
-    int n, k;
-    cin >> n >> k;
-    
-    cerr << "Starting: n=" << n << ", initial k=" << k << endl;
-    
-    // Already solved (shouldn't happen according to problem)
-    if (k == 1) {
-        cerr << "Already solved!" << endl;
-        return 0;
+TraceRing trace;
+#endif
+
+// The real machine behind the judge's stdin/stdout protocol
+class InteractiveMachine : public SlotMachine {
+public:
+    explicit InteractiveMachine(ReplyReader& in) : in(in) {}
+
+    // Send a rotation command and receive the new k value
+    int rotate(int wheel, int delta) override {
+        char line[32];
+        int len = snprintf(line, sizeof(line), "%d %d\n", wheel, delta);
+        writeAll(line, len);
+
+        int new_k = in.nextInt();
+        actions++;
+#ifdef SLOT_TRACE
+        trace.add(wheel, delta, new_k);
+#endif
+        // A closed judge ends the game; report k=1 so the strategy stops
+        return new_k < 0 ? 1 : new_k;
     }
-    
-    int pass = 0;
-    const int MAX_PASSES = 5;  // Usually 2-3 passes suffice
-    
-    while (k > 1 && pass < MAX_PASSES && total_actions < MAX_ACTIONS - 2*n) {
-        pass++;
-        cerr << "\n=== Pass " << pass << " ===" << endl;
-        
-        bool improved = false;
-        int initial_k = k;
-        
-        // Optimize each wheel (except wheel 1 which is our reference)
-        for (int wheel = 2; wheel <= n && k > 1; wheel++) {
-            cerr << "Optimizing wheel " << wheel << "..." << endl;
-            
-            // Use the optimized version (single large rotation)
-            // Comment out next line and uncomment the one after to use multiple +1 rotations
-            auto [best_pos, new_k] = find_best_position_optimized(wheel, n, k);
-            // auto [best_pos, new_k] = find_best_position(wheel, n, k);
-            
-            if (new_k < k) {
-                improved = true;
-                cerr << "Wheel " << wheel << " improved k from " << k 
-                     << " to " << new_k << " at position " << best_pos << endl;
-            }
-            
-            k = new_k;
-            
-            // Goal achieved
-            if (k == 1) {
-                cerr << "SUCCESS! Solved in " << total_actions << " actions" << endl;
-                return 0;
-            }
-            
-            // Check action limit
-            if (total_actions >= MAX_ACTIONS - 2*n) {
-                cerr << "Approaching action limit, stopping..." << endl;
-                break;
+
+private:
+    static void writeAll(const char* p, size_t len) {
+        while (len > 0) {
+            ssize_t w = write(1, p, len);
+            if (w < 0) {
+                if (errno == EINTR) continue;
+                return;
             }
-        }
-        
-        cerr << "Pass " << pass << " complete: k reduced from " 
-             << initial_k << " to " << k << endl;
-        
-        // Stop if no improvement in this pass
-        if (!improved) {
-            cerr << "No improvement in pass " << pass << ", stopping" << endl;
-            break;
+            p += w;
+            len -= w;
         }
     }
-    
+
+    ReplyReader& in;
+};
+
+int main() {
+    ReplyReader in;
+    int n = in.nextInt();
+    int k = in.nextInt();
+    if (n < 0 || k < 0) return 0;
+
+    InteractiveMachine machine(in);
+#ifdef SLOT_TRACE
+    atexit([] { trace.dump(); });
+    machine.log = &cerr;
+    cerr << "Starting: n=" << n << ", initial k=" << k << endl;
+#endif
+    k = solve_by_inference(machine, n, k);
+
+#ifdef SLOT_TRACE
     if (k == 1) {
-        cerr << "SUCCESS! Solved in " << total_actions << " actions" << endl;
+        cerr << "SUCCESS! Solved in " << machine.actions << " actions" << endl;
     } else {
-        cerr << "Failed to solve: k=" << k << " after " << total_actions << " actions" << endl;
+        cerr << "Failed to solve: k=" << k << " after " << machine.actions << " actions" << endl;
     }
-    
+#endif
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,380 @@
+#include <bits/stdc++.h>
+using namespace std;
+
+// Count or enumerate every cup order with tower height exactly h
+//
+// Usage: ./cup_orders [--mod=M] [--threads=T] < input.txt
+//        ./cup_orders --enumerate [--limit=K] [--threads=T] < input.txt
+//
+// Input is the same "n h" line as for the solution. The default prints the
+// exact number of orders in decimal; --mod=M prints it modulo M instead.
+// --enumerate prints the orders (cup heights, bottom to top, one order per
+// line) in lexicographic order, at most K of them with --limit=K.
+//
+// Both build on H = sum(T) + n - |T| for the leaders T of the maximal
+// decreasing groups, i.e. h - n = sum over leaders v of (v - 1).
+
+// ---------------------------------------------------------------------------
+// Counting
+//
+// Insert the cups from largest to smallest. A newly inserted cup v is a
+// leader iff it ends up first or the gap to its left receives a later
+// (smaller) cup. "Gap must be non-empty" is written as "any" minus "empty",
+// which leaves only the number a of usable gaps besides the front as state:
+//   front gap          -> leader,          a + 1, weight 1
+//   one of a gaps, any -> leader,          a + 1, weight a
+//   one of a gaps, empty -> leader,        a,     weight -a
+//   one of a gaps, empty -> not a leader,  a,     weight a
+// Pulling into row a with w = v - 1:
+//   new[a][s] = a * (dp[a][s] - dp[a][s - w] + dp[a - 1][s - w])
+// Rows are independent, so each step is split over threads by rows. Only
+// sums that can still reach the target are stored.
+// ---------------------------------------------------------------------------
+
+// Number of orders with leader excess exactly target, modulo p (p < 2^31)
+uint32_t countModulo(int n, long long target, uint32_t p, int threads) {
+    auto tri = [](long long x) { return x > 0 ? x * (x + 1) / 2 : 0LL; };
+    if (n == 1) return target == 0 ? 1 % p : 0;
+
+    // After placing cup n: a = 1, sum = n - 1. Cups v = n-1..1 remain, which
+    // add at most tri(v - 1) between them.
+    long long lo = max(0LL, target - tri(n - 2));
+    if (n - 1 > target || n - 1 < lo) return 0;
+    int rows = 2;  // a = 0..rows-1, row 0 stays zero
+    long long width = target - lo + 1;
+    vector<uint32_t> dp(rows * width, 0);
+    dp[1 * width + (n - 1 - lo)] = 1 % p;
+
+    vector<uint32_t> next;
+    for (int v = n - 1; v >= 1; v--) {
+        long long w = v - 1;
+        long long nlo = max(0LL, target - tri(v - 2));
+        long long nwidth = target - nlo + 1;
+        int nrows = rows + 1;
+        next.assign((size_t)nrows * nwidth, 0);
+
+        // Rows a and a-1 of dp, or null past the last row; s >= nlo >= lo, so
+        // only the shifted reads s - w can fall below the stored window
+        auto work = [&](int firstRow, int step) {
+            for (int a = firstRow; a < nrows; a += step) {
+                const uint32_t* cur = a < rows ? &dp[(size_t)a * width] - lo : nullptr;
+                const uint32_t* prev = a - 1 < rows ? &dp[(size_t)(a - 1) * width] - lo : nullptr;
+                uint32_t* out = &next[(size_t)a * nwidth] - nlo;
+                long long shifted = max(nlo, lo + w);  // first s with s - w stored
+                for (long long s = nlo; s < shifted; s++) {
+                    uint64_t x = cur ? cur[s] : 0;
+                    out[s] = (uint32_t)((uint64_t)a * x % p);
+                }
+                for (long long s = shifted; s <= target; s++) {
+                    uint64_t x = (cur ? (uint64_t)cur[s] + p - cur[s - w] : 0) + prev[s - w];
+                    out[s] = (uint32_t)((uint64_t)a * x % p);
+                }
+            }
+        };
+        vector<thread> pool;
+        for (int t = 1; t < threads; t++) pool.emplace_back(work, 1 + t, threads);
+        work(1, threads);
+        for (auto& th : pool) th.join();
+
+        dp.swap(next);
+        rows = nrows;
+        lo = nlo;
+        width = nwidth;
+    }
+
+    uint64_t total = 0;
+    for (int a = 1; a < rows; a++) total += dp[(size_t)a * width + (target - lo)];
+    return (uint32_t)(total % p);
+}
+
+bool isPrime(uint32_t x) {
+    if (x < 2) return false;
+    for (uint32_t d = 2; (uint64_t)d * d <= x; d++) {
+        if (x % d == 0) return false;
+    }
+    return true;
+}
+
+uint32_t powMod(uint64_t b, uint64_t e, uint32_t p) {
+    uint64_t r = 1 % p;
+    b %= p;
+    for (; e; e >>= 1, b = b * b % p) {
+        if (e & 1) r = r * b % p;
+    }
+    return (uint32_t)r;
+}
+
+// Exact count from residues modulo enough primes below 2^31 to exceed n!
+// (Garner's mixed-radix form, then Horner in base 10^9)
+string countExact(int n, long long target, int threads) {
+    double bits = 1;
+    for (int i = 2; i <= n; i++) bits += log2((double)i);
+
+    vector<uint32_t> primes, residues;
+    for (uint32_t p = (1u << 31) - 1; bits > 0; p -= 2) {
+        if (!isPrime(p)) continue;
+        primes.push_back(p);
+        residues.push_back(countModulo(n, target, p, threads));
+        bits -= log2((double)p);
+    }
+
+    size_t k = primes.size();
+    vector<uint32_t> digit(k);
+    for (size_t i = 0; i < k; i++) {
+        // value of the prefix sum_{j<i} digit[j] * prod_{l<j} p_l, mod p_i
+        uint64_t prefix = 0, radix = 1;
+        for (size_t j = 0; j < i; j++) {
+            prefix = (prefix + digit[j] * radix) % primes[i];
+            radix = radix * primes[j] % primes[i];
+        }
+        uint64_t diff = (residues[i] + primes[i] - prefix) % primes[i];
+        digit[i] = (uint32_t)(diff * powMod(radix, primes[i] - 2, primes[i]) % primes[i]);
+    }
+
+    const uint32_t BASE = 1000000000;
+    vector<uint32_t> big;  // little-endian base 10^9
+    for (size_t i = k; i-- > 0;) {
+        uint64_t carry = digit[i];
+        for (uint32_t& limb : big) {
+            uint64_t cur = (uint64_t)limb * primes[i] + carry;
+            limb = (uint32_t)(cur % BASE);
+            carry = cur / BASE;
+        }
+        while (carry) {
+            big.push_back((uint32_t)(carry % BASE));
+            carry /= BASE;
+        }
+    }
+    while (!big.empty() && big.back() == 0) big.pop_back();
+    if (big.empty()) return "0";
+
+    string out = to_string(big.back());
+    char limb[16];
+    for (size_t i = big.size() - 1; i-- > 0;) {
+        snprintf(limb, sizeof(limb), "%09u", big[i]);
+        out += limb;
+    }
+    return out;
+}
+
+// ---------------------------------------------------------------------------
+// Enumeration
+//
+// Depth-first, bottom to top, smallest cup first (lexicographic output). For
+// the cups R still to place after a cup l, the leader excess they can add is
+// exactly bounded by
+//   min = max(R) > l ? max(R) - 1 : 0            (R in descending order)
+//   max = sum(R - 1) - (min(R) < l ? min(R) - 1 : 0)   (R ascending)
+// and branches whose remaining target falls outside are cut. The first two
+// cups form the tasks, which threads take in order; each task buffers its
+// lines and tasks are written in order.
+// ---------------------------------------------------------------------------
+
+class OrderEnumerator {
+public:
+    OrderEnumerator(int n, long long target) : n(n), words((n + 64) / 64), target(target) {}
+
+    // All two-cup prefixes (just {1} for n = 1), in lexicographic order
+    vector<vector<int>> tasks() const {
+        vector<vector<int>> out;
+        for (int a = 1; a <= n; a++) {
+            if (n == 1) {
+                out.push_back({a});
+                continue;
+            }
+            for (int b = 1; b <= n; b++) {
+                if (b != a) out.push_back({a, b});
+            }
+        }
+        return out;
+    }
+
+    // Append up to limit orders that start with prefix to out; returns count
+    long long run(const vector<int>& prefix, long long limit, string& out) const {
+        State st;
+        st.free.assign(words, 0);
+        for (int v = 1; v <= n; v++) st.free[v >> 6] |= 1ULL << (v & 63);
+        st.excessLeft = n * (long long)(n - 1) / 2;  // sum(v - 1) over free cups
+        st.rem = target;
+        st.path.clear();
+        st.limit = limit;
+        st.out = &out;
+        for (int v : prefix) {
+            if (!feasibleAfter(st, v)) return 0;
+            place(st, v);
+        }
+        dfs(st);
+        return st.found;
+    }
+
+private:
+    struct State {
+        vector<uint64_t> free;
+        long long excessLeft = 0;
+        long long rem = 0;
+        vector<int> path;
+        long long limit = 0, found = 0;
+        string* out = nullptr;
+    };
+
+    int n, words;
+    long long target;
+
+    int lowest(const State& st) const {
+        for (int i = 0; i < words; i++) {
+            if (st.free[i]) return i * 64 + __builtin_ctzll(st.free[i]);
+        }
+        return 0;
+    }
+
+    int highest(const State& st) const {
+        for (int i = words - 1; i >= 0; i--) {
+            if (st.free[i]) return i * 64 + 63 - __builtin_clzll(st.free[i]);
+        }
+        return 0;
+    }
+
+    int last(const State& st) const { return st.path.empty() ? 0 : st.path.back(); }
+
+    void place(State& st, int v) const {
+        if (v > last(st)) st.rem -= v - 1;
+        st.free[v >> 6] &= ~(1ULL << (v & 63));
+        st.excessLeft -= v - 1;
+        st.path.push_back(v);
+    }
+
+    void unplace(State& st, int v, long long rem) const {
+        st.path.pop_back();
+        st.free[v >> 6] |= 1ULL << (v & 63);
+        st.excessLeft += v - 1;
+        st.rem = rem;
+    }
+
+    // Whether placing v next keeps the remaining target within the bounds
+    bool feasibleAfter(State& st, int v) const {
+        if (!(st.free[v >> 6] >> (v & 63) & 1)) return false;
+        long long rem = st.rem;
+        place(st, v);
+        bool ok = st.rem >= 0;
+        if (ok && (int)st.path.size() < n) {
+            int mx = highest(st), mn = lowest(st);
+            long long lower = mx > v ? mx - 1 : 0;
+            long long upper = st.excessLeft - (mn < v ? mn - 1 : 0);
+            ok = lower <= st.rem && st.rem <= upper;
+        } else if (ok) {
+            ok = st.rem == 0;
+        }
+        unplace(st, v, rem);
+        return ok;
+    }
+
+    void dfs(State& st) const {
+        if (st.found >= st.limit) return;
+        if ((int)st.path.size() == n) {
+            char buf[16];
+            for (int i = 0; i < n; i++) {
+                if (i) *st.out += ' ';
+                auto res = to_chars(buf, buf + sizeof(buf), 2 * st.path[i] - 1);
+                st.out->append(buf, res.ptr);
+            }
+            *st.out += '\n';
+            st.found++;
+            return;
+        }
+        for (int i = 0; i < words; i++) {
+            for (uint64_t m = st.free[i]; m; m &= m - 1) {
+                int v = i * 64 + __builtin_ctzll(m);
+                if (!feasibleAfter(st, v)) continue;
+                long long rem = st.rem;
+                place(st, v);
+                dfs(st);
+                unplace(st, v, rem);
+                if (st.found >= st.limit) return;
+            }
+        }
+    }
+};
+
+void enumerateOrders(int n, long long target, long long limit, int threads) {
+    OrderEnumerator en(n, target);
+    vector<vector<int>> tasks = en.tasks();
+
+    long long printed = 0;
+    const size_t BLOCK = 4 * (size_t)threads;
+    vector<string> outputs(BLOCK);
+    for (size_t begin = 0; begin < tasks.size() && printed < limit; begin += BLOCK) {
+        size_t end = min(tasks.size(), begin + BLOCK);
+        long long budget = limit - printed;  // no task needs more than this
+        atomic<size_t> nextTask{begin};
+        auto worker = [&]() {
+            for (size_t i; (i = nextTask.fetch_add(1)) < end;) {
+                outputs[i - begin].clear();
+                en.run(tasks[i], budget, outputs[i - begin]);
+            }
+        };
+        vector<thread> pool;
+        for (int t = 1; t < threads; t++) pool.emplace_back(worker);
+        worker();
+        for (auto& th : pool) th.join();
+
+        for (size_t i = begin; i < end && printed < limit; i++) {
+            const string& s = outputs[i - begin];
+            size_t pos = 0;
+            while (pos < s.size() && printed < limit) {
+                size_t eol = s.find('\n', pos);
+                fwrite(s.data() + pos, 1, eol + 1 - pos, stdout);
+                pos = eol + 1;
+                printed++;
+            }
+        }
+    }
+}
+
+int main(int argc, char* argv[]) {
+    long long mod = 0;  // 0 = exact
+    bool enumerate = false;
+    long long limit = LLONG_MAX;
+    int threads = max(1u, thread::hardware_concurrency());
+
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (arg.rfind("--mod=", 0) == 0) {
+            mod = atoll(arg.c_str() + 6);
+            if (mod < 1 || mod >= (1LL << 31)) {
+                cerr << "Error: --mod must be in [1, 2^31)\n";
+                return 1;
+            }
+        } else if (arg == "--enumerate") {
+            enumerate = true;
+        } else if (arg.rfind("--limit=", 0) == 0) {
+            limit = max(0LL, atoll(arg.c_str() + 8));
+        } else if (arg.rfind("--threads=", 0) == 0) {
+            threads = max(1, atoi(arg.c_str() + 10));
+        } else {
+            cerr << "Usage: " << argv[0] << " [--mod=M | --enumerate [--limit=K]] [--threads=T]"
+                 << " < input.txt\n";
+            return 1;
+        }
+    }
+
+    long long n, h;
+    if (!(cin >> n >> h)) return 0;
+
+    // Orders exist only for Hmin = 2n - 1 <= h <= Hmax = n(n + 1)/2
+    bool possible = n >= 1 && (__int128)h >= 2 * (__int128)n - 1
+                 && (__int128)h <= (__int128)n * (n + 1) / 2;
+    if (possible && n > 100000) {
+        cerr << "Error: n too large for counting or enumeration\n";
+        return 1;
+    }
+    long long target = possible ? h - n : 0;
+
+    if (enumerate) {
+        if (possible) enumerateOrders((int)n, target, limit, threads);
+    } else if (mod > 0) {
+        cout << (possible ? countModulo((int)n, target, (uint32_t)mod, threads) : 0) << "\n";
+    } else {
+        cout << (possible ? countExact((int)n, target, threads) : "0") << "\n";
+    }
+    return 0;
+}
@@ -2,7 +2,7 @@
 
 # Compile the solution
 echo "Compiling solution..."
-g++ -O2 -std=c++17 solution.cpp -o solution
+g++ -O2 -std=c++17 -pthread solution.cpp -o solution
 if [ $? -ne 0 ]; then
     echo "Compilation failed!"
     exit 1
@@ -32,11 +32,54 @@ for test_file in $test_dir/test*.txt; do
             echo "  Got: $(cat temp_output.txt)"
             ((failed++))
         fi
+
+        echo -n "Running $test_name (--stream)... "
+        ./solution --stream < "$test_file" > temp_output.txt
+        if diff -B -w "$expected_file" temp_output.txt > /dev/null 2>&1; then
+            echo "PASSED"
+            ((passed++))
+        else
+            echo "FAILED"
+            echo "  Expected: $(cat "$expected_file")"
+            echo "  Got: $(cat temp_output.txt)"
+            ((failed++))
+        fi
+    fi
+done
+
+# Batch mode: all tests in one run must match the expected outputs in order
+echo -n "Running batch mode... "
+for f in $test_dir/test*.txt; do cat "$f"; echo; done | ./solution --batch=2 > temp_output.txt
+for f in $test_dir/test*.txt; do t=$(basename "$f" .txt); cat "$test_dir/expected${t#test}.txt"; echo; done > temp_expected.txt
+if diff -B -w temp_expected.txt temp_output.txt > /dev/null 2>&1; then
+    echo "PASSED"
+    ((passed++))
+else
+    echo "FAILED"
+    ((failed++))
+fi
+
+# Order enumeration: every expected tower must be one of the enumerated
+# orders, and the exact count must match the number of enumerated lines
+g++ -O2 -std=c++17 -pthread cup_orders.cpp -o cup_orders
+for test_file in $test_dir/test*.txt; do
+    test_name=$(basename "$test_file" .txt)
+    expected_file="$test_dir/expected${test_name#test}.txt"
+    grep -q impossible "$expected_file" && continue
+    echo -n "Running $test_name (cup_orders)... "
+    ./cup_orders --enumerate < "$test_file" > temp_output.txt
+    count=$(./cup_orders < "$test_file")
+    if grep -qx "$(cat "$expected_file")" temp_output.txt && [ "$count" -eq "$(wc -l < temp_output.txt)" ]; then
+        echo "PASSED ($count orders)"
+        ((passed++))
+    else
+        echo "FAILED"
+        ((failed++))
     fi
 done
 
 # Clean up
-rm -f temp_output.txt solution
+rm -f temp_output.txt temp_expected.txt solution cup_orders
 
 echo ""
 echo "Results: $passed passed, $failed failed"
@@ -1,94 +1,147 @@
 #include <bits/stdc++.h>
+#include "../common/fast_input.h"
+#include "../common/fast_output.h"
+#include "stacking_cups.h"
 using namespace std;
 
-int main() {
-    ios::sync_with_stdio(false);
-    cin.tie(nullptr);
+// Usage: ./solution [--stream | --batch[=THREADS] [--prefix=K] [--checksum]] < input.txt
+//   --stream    emit the permutation straight from the greedy subset in one
+//               pass, with O(1) memory apart from a fixed output buffer
+//   --batch     read "n h" pairs until EOF and answer each on its own line,
+//               in input order, using THREADS threads (default: all cores)
+//   --prefix=K  batch: print only the bottom K cups of each tower
+//   --checksum  batch: print "n hash" (64-bit FNV-1a of the heights) instead
 
-    long long n, h;
-    if (!(cin >> n >> h)) return 0;
+void streamPermutation(FastOutput& out, long long n, long long s) {
+    CupOrder order(n, s);
+    long long cup;
+    bool first = true;
+    while (order.next(cup)) {
+        if (!first) out << ' ';
+        first = false;
+        out << 2 * cup - 1;
+    }
+    out << '\n';
+}
 
-    if (n <= 0) {
-        cout << "impossible\n";
-        return 0;
+// What batch mode prints for each feasible query
+struct BatchFormat {
+    long long prefix = -1;  // cups to print, -1 = all
+    bool checksum = false;  // print "n hash" instead of the cups
+};
+
+void appendUint(string& out, unsigned long long v) {
+    char tmp[20];
+    out.append(tmp, formatUint(tmp, v));
+}
+
+string answerQuery(long long n, long long h, const BatchFormat& fmt) {
+    long long s;
+    if (!extraHeight(n, h, s)) return "impossible\n";
+    CupOrder order(n, s);
+    string out;
+    if (fmt.checksum) {
+        appendUint(out, n);
+        out += ' ';
+        appendUint(out, towerChecksum(order));
+    } else {
+        long long cup;
+        for (long long i = 0; (fmt.prefix < 0 || i < fmt.prefix) && order.next(cup); i++) {
+            if (i) out += ' ';
+            appendUint(out, 2 * cup - 1);
+        }
     }
+    out += '\n';
+    return out;
+}
 
-    // Feasibility bounds under the correct model:
-    // Total height H for a permutation partitioned into decreasing groups
-    // with leaders T is: H = sum(T) + n - |T|.
-    // Therefore:
-    //   Hmin = 2n - 1  (single group with leader n),
-    //   Hmax = n(n + 1)/2 (all singleton groups).
-    __int128 Hmin = 2 * (__int128)n - 1;
-    __int128 Hmax = ((__int128)n * (n + 1)) / 2;
+// Answer "n h" pairs until EOF, one line each in input order. Blocks of
+// queries are answered by a thread pool and written before the next block.
+void runBatch(FastInput& in, FastOutput& out, int threads, const BatchFormat& fmt) {
+    vector<pair<long long, long long>> queries;
+    long long n, h;
+    while (in >> n >> h) queries.push_back({n, h});
 
-    if ((__int128)h < Hmin || (__int128)h > Hmax) {
-        cout << "impossible\n";
-        return 0;
+    const size_t BLOCK = 64 * (size_t)threads;
+    vector<string> answers(BLOCK);
+    for (size_t begin = 0; begin < queries.size(); begin += BLOCK) {
+        size_t end = min(queries.size(), begin + BLOCK);
+        atomic<size_t> nextQuery{begin};
+        auto worker = [&]() {
+            for (size_t i; (i = nextQuery.fetch_add(1)) < end;) {
+                answers[i - begin] = answerQuery(queries[i].first, queries[i].second, fmt);
+            }
+        };
+        vector<thread> pool;
+        for (int t = 1; t < threads; t++) pool.emplace_back(worker);
+        worker();
+        for (auto& th : pool) th.join();
+        for (size_t i = begin; i < end; i++) {
+            out << answers[i - begin];
+        }
     }
+}
 
-    // Extra height beyond minimal configuration:
-    // E = h - Hmin = sum_{t in additional leaders}(t - 1).
-    // Represent E as sum of distinct integers from {1, 2, ..., n-2}.
-    long long s = (long long)((__int128)h - Hmin);
+int main(int argc, char* argv[]) {
+    FastInput in;
+    FastOutput out;
 
-    // Greedy subset selection from {1, 2, ..., n-2}.
-    // This always succeeds since the set is consecutive and
-    // sum_{a=1}^{n-2} a = (n-1)(n-2)/2 = Hmax - Hmin.
-    vector<long long> moves;
-    for (long long a = n - 2; a >= 1; --a) {
-        if (s >= a) {
-            moves.push_back(a);
-            s -= a;
+    bool stream = false;
+    int batchThreads = 0;
+    BatchFormat fmt;
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (arg == "--stream") {
+            stream = true;
+        } else if (arg == "--batch") {
+            batchThreads = max(1u, thread::hardware_concurrency());
+        } else if (arg.rfind("--batch=", 0) == 0) {
+            batchThreads = max(1, atoi(arg.c_str() + 8));
+        } else if (arg.rfind("--prefix=", 0) == 0) {
+            fmt.prefix = max(0LL, atoll(arg.c_str() + 9));
+        } else if (arg == "--checksum") {
+            fmt.checksum = true;
+        } else {
+            cerr << "Usage: " << argv[0] << " [--stream | --batch[=THREADS] [--prefix=K] [--checksum]]"
+                 << " < input.txt\n";
+            return 1;
         }
     }
-    if (s != 0) {
-        // This should be unreachable due to the feasibility check above.
-        cout << "impossible\n";
-        return 0;
+    if ((fmt.prefix >= 0 || fmt.checksum) && batchThreads == 0) {
+        cerr << "Error: --prefix and --checksum need --batch\n";
+        return 1;
     }
 
-    // Construct the permutation by starting from the fully decreasing order
-    // [n, n-1, ..., 1]. For each a in moves (processed in descending order),
-    // move cup 'a' to immediately before cup 'a+1'.
-    // This creates a new group boundary just before (a+1), making (a+1) a leader,
-    // and increases the total height by exactly 'a'.
-    vector<long long> L(n + 2, 0), R(n + 2, 0);
-    long long head = n;
-    for (long long i = n; i >= 1; --i) {
-        R[i] = (i - 1 >= 1 ? i - 1 : 0);
-        L[i] = (i + 1 <= n ? i + 1 : 0);
+    if (batchThreads > 0) {
+        runBatch(in, out, batchThreads, fmt);
+        return 0;
     }
 
-    auto detach = [&](long long x) {
-        long long l = L[x], r = R[x];
-        if (l != 0) R[l] = r; else head = r;
-        if (r != 0) L[r] = l;
-        L[x] = R[x] = 0;
-    };
-
-    auto insert_before = [&](long long x, long long t) {
-        long long l = L[t];
-        L[x] = l; R[x] = t;
-        if (l != 0) R[l] = x; else head = x;
-        L[t] = x;
-    };
+    long long n, h;
+    if (!(in >> n >> h)) return 0;
 
-    // Process moves in descending 'a' (already constructed that way).
-    for (long long a : moves) {
-        long long t = a + 1;
-        if (R[a] == t) continue; // already positioned
-        detach(a);
-        insert_before(a, t);
+    if (stream) {
+        long long s;
+        if (!extraHeight(n, h, s)) {
+            out << "impossible\n";
+            return 0;
+        }
+        streamPermutation(out, n, s);
+        return 0;
     }
 
-    // Output cup heights (2*i - 1) from bottom (head) to top.
+    StackingCupsWorkspace workspace;
+    const vector<long long>& tower = solve(StackingCupsQuery{n, h}, workspace);
+    if (tower.empty()) {
+        out << "impossible\n";
+        return 0;
+    }
     bool first = true;
-    for (long long cur = head; cur != 0; cur = R[cur]) {
-        if (!first) cout << ' ';
+    for (long long height : tower) {
+        if (!first) out << ' ';
         first = false;
-        cout << (2 * cur - 1);
+        out << height;
     }
-    cout << '\n';
+    out << '\n';
     return 0;
-}
\ No newline at end of file
+}
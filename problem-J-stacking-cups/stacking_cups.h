@@ -0,0 +1,185 @@
+/*
+ * Problem J: Stacking Cups
+ *
+ * solve() returns the cup heights from bottom to top for a tower of height
+ * h, or an empty list if none exists. CupOrder produces the same tower
+ * lazily when only a prefix or a hash is needed.
+ */
+
+#pragma once
+
+#include <cmath>
+#include <vector>
+
+// Feasibility in O(1). Under the correct model the total height H of a
+// permutation partitioned into decreasing groups with leaders T is
+// H = sum(T) + n - |T|, so Hmin = 2n - 1 (single group with leader n) and
+// Hmax = n(n + 1)/2 (all singleton groups). On success s = h - Hmin is the
+// extra height, to be written as a sum of distinct values from {1..n-2}.
+inline bool extraHeight(long long n, long long h, long long& s) {
+    if (n <= 0) return false;
+    __int128 Hmin = 2 * (__int128)n - 1;
+    __int128 Hmax = ((__int128)n * (n + 1)) / 2;
+    if ((__int128)h < Hmin || (__int128)h > Hmax) return false;
+    s = (long long)((__int128)h - Hmin);
+    return true;
+}
+
+// Lazily generated tower, bottom to top, for extra height s.
+//
+// The greedy subset of {1..n-2} summing to s is always a top block
+// [q+1, n-2] plus at most one smaller value r (0 = none). With the moves
+// applied as in the list construction, each run of moved cups ends up in
+// ascending order right below the unmoved cup above it. q comes from a
+// square root, so construction is O(1) and a prefix of K cups costs O(K).
+class CupOrder {
+public:
+    CupOrder(long long n, long long s) : n(n), c(n) {
+        long long m = n - 2;
+        q = m;
+        if (m >= 1) {
+            // Smallest q >= 0 with sum[q+1..m] = T(m) - T(q) <= s
+            __int128 need = tri(m) - s;
+            q = 0;
+            if (need > 0) {
+                q = (long long)((std::sqrt(8.0L * (long double)need + 1) - 1) / 2);
+                while (tri(q) < need) q++;
+                while (q > 0 && tri(q - 1) >= need) q--;
+            }
+            s -= (long long)(tri(m) - tri(q));
+        }
+        r = s;
+        settle();
+    }
+
+    // Next cup index (1-based), or false once the tower is complete
+    bool next(long long& cup) {
+        if (c < 1) return false;
+        if (a < c) {
+            cup = a++;
+            return true;
+        }
+        cup = c--;
+        settle();
+        return true;
+    }
+
+    long long size() const { return n; }
+
+private:
+    static __int128 tri(long long x) { return (__int128)x * (x + 1) / 2; }
+
+    bool moved(long long x) const { return (x > q && x <= n - 2) || x == r; }
+
+    // Step c down to the next unmoved cup and a to the start of its run
+    void settle() {
+        while (c >= 1 && moved(c)) c = (c == r) ? r - 1 : q;
+        if (c < 1) return;
+        a = c;
+        if (c - 1 >= 1 && moved(c - 1)) a = (c - 1 == r) ? r : q + 1;
+    }
+
+    long long n, q, r;
+    long long c;      // next unmoved cup
+    long long a = 0;  // next cup of the run below c
+};
+
+// 64-bit FNV-1a over the cup heights, bottom to top
+inline unsigned long long towerChecksum(CupOrder& order) {
+    unsigned long long hash = 1469598103934665603ULL;
+    long long cup;
+    while (order.next(cup)) {
+        hash ^= (unsigned long long)(2 * cup - 1);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+struct StackingCupsQuery {
+    long long n = 0;   // cups
+    long long h = 0;   // tower height
+};
+
+class StackingCupsWorkspace {
+public:
+    // Cup heights bottom to top, empty if impossible; valid until the next call
+    const std::vector<long long>& solve(const StackingCupsQuery& query) {
+        tower.clear();
+        long long n = query.n;
+        long long s;
+        if (!extraHeight(n, query.h, s)) return tower;
+
+        // Greedy subset selection from {1, 2, ..., n-2}.
+        // This always succeeds since the set is consecutive and
+        // sum_{a=1}^{n-2} a = (n-1)(n-2)/2 = Hmax - Hmin.
+        moves.clear();
+        for (long long a = n - 2; a >= 1; --a) {
+            if (s >= a) {
+                moves.push_back(a);
+                s -= a;
+            }
+        }
+        if (s != 0) {
+            // This should be unreachable due to the feasibility check above.
+            return tower;
+        }
+
+        // Construct the permutation by starting from the fully decreasing order
+        // [n, n-1, ..., 1]. For each a in moves (processed in descending order),
+        // move cup 'a' to immediately before cup 'a+1'.
+        // This creates a new group boundary just before (a+1), making (a+1) a leader,
+        // and increases the total height by exactly 'a'.
+        L.assign(n + 2, 0);
+        R.assign(n + 2, 0);
+        head = n;
+        for (long long i = n; i >= 1; --i) {
+            R[i] = (i - 1 >= 1 ? i - 1 : 0);
+            L[i] = (i + 1 <= n ? i + 1 : 0);
+        }
+
+        // Process moves in descending 'a' (already constructed that way).
+        for (long long a : moves) {
+            long long t = a + 1;
+            if (R[a] == t) continue; // already positioned
+            detach(a);
+            insertBefore(a, t);
+        }
+
+        // Cup heights (2*i - 1) from bottom (head) to top.
+        tower.reserve(n);
+        for (long long cur = head; cur != 0; cur = R[cur]) {
+            tower.push_back(2 * cur - 1);
+        }
+        return tower;
+    }
+
+private:
+    void detach(long long x) {
+        long long l = L[x], r = R[x];
+        if (l != 0) R[l] = r; else head = r;
+        if (r != 0) L[r] = l;
+        L[x] = R[x] = 0;
+    }
+
+    void insertBefore(long long x, long long t) {
+        long long l = L[t];
+        L[x] = l; R[x] = t;
+        if (l != 0) R[l] = x; else head = x;
+        L[t] = x;
+    }
+
+    std::vector<long long> moves;
+    std::vector<long long> L, R;   // doubly linked list of cups
+    long long head = 0;
+    std::vector<long long> tower;
+};
+
+inline const std::vector<long long>& solve(const StackingCupsQuery& query,
+                                           StackingCupsWorkspace& workspace) {
+    return workspace.solve(query);
+}
+
+inline std::vector<long long> solve(const StackingCupsQuery& query) {
+    StackingCupsWorkspace workspace;
+    return solve(query, workspace);
+}
@@ -1,8 +1,8 @@
 #!/bin/bash
 
-# Compile the corrected solution
-echo "Compiling treasure_map_fixed.cpp..."
-g++ -std=c++17 -O2 -o treasure_map_fixed treasure_map_fixed.cpp
+# Compile the solution
+echo "Compiling solution.cpp..."
+g++ -std=c++17 -O2 -o solution solution.cpp
 if [ $? -ne 0 ]; then
     echo "Compilation failed!"
     exit 1
@@ -11,48 +11,61 @@ fi
 echo "Running tests..."
 echo "==============="
 
-# Test 1
-echo -e "\nTest Case 1:"
-echo "3 3 5 1 1
-1 3 1
-3 3 2
-2 3 3
-2 2 4
-2 1 5" | ./treasure_map_fixed
-echo "Expected: 3"
-
-# Test 2
-echo -e "\nTest Case 2:"
-echo "3 5 4 3 4
-2 4 1
-2 2 2
-1 1 4
-3 1 5" | ./treasure_map_fixed
-echo "Expected: 1"
-
-# Test 3
-echo -e "\nTest Case 3:"
-echo "3 3 3 3 3
-2 3 1
-2 1 2
-1 2 4" | ./treasure_map_fixed
-echo "Expected: 0"
-
-# Test 4
-echo -e "\nTest Case 4:"
-echo "3 3 4 3 2
-2 1 2
-2 3 3
-1 3 4
-1 1 5" | ./treasure_map_fixed
-echo "Expected: impossible"
-
-# Test 5
-echo -e "\nTest Case 5:"
-echo "3 3 3 2 2
-3 2 0
-2 2 1
-2 3 0" | ./treasure_map_fixed
-echo "Expected: impossible"
-
-echo -e "\nAll tests completed!"
\ No newline at end of file
+passed=0
+failed=0
+
+check() {
+    local name="$1" expected="$2" got="$3"
+    if [ "$got" = "$expected" ]; then
+        echo "$name: $got ✓"
+        ((passed++))
+    else
+        echo "$name: $got ✗ (expected: $expected)"
+        ((failed++))
+    fi
+}
+
+for test_file in test_inputs/test*.txt; do
+    test_name=$(basename "$test_file" .txt)
+    expected=$(cat "test_inputs/expected${test_name#test}.txt")
+
+    check "$test_name" "$expected" "$(./solution < "$test_file")"
+
+    # The online answer after the last reading is the batch answer
+    check "$test_name (--online, last reading)" "$expected" "$(./solution --online < "$test_file" | tail -n 1)"
+
+    # Query the treasure point itself, and read it off the depth map
+    read -r n m k tx ty < "$test_file"
+    check "$test_name (--queries)" "$expected" "$( (cat "$test_file"; echo; echo "$tx $ty") | ./solution --queries)"
+    map=$(./solution --depth-map < "$test_file")
+    if [ "$map" != "impossible" ]; then
+        map=$(echo "$map" | sed -n "${tx}p" | cut -d' ' -f"$ty")
+    fi
+    check "$test_name (--depth-map)" "$expected" "$map"
+done
+
+# Concurrent runner: built-in samples plus test_inputs, with time/RSS limits
+echo "Compiling test_runner.cpp..."
+if g++ -std=c++17 -O2 -o test_runner test_runner.cpp \
+    && ./test_runner ./solution --dir=test_inputs --timeout=5 --cpu-timeout=2 > /dev/null; then
+    echo "test_runner: all cases passed ✓"
+    ((passed++))
+else
+    echo "test_runner: failures ✗ (run ./test_runner ./solution --dir=test_inputs)"
+    ((failed++))
+fi
+
+# A solution that exits without reading its input must be reported as failed
+# cases with a summary, not kill the runner with SIGPIPE (racy, so try a few)
+ignored="1 1"
+for run in 1 2 3 4 5; do
+    out=$(./test_runner /bin/true --jobs=1)
+    ignored="$? $(echo "$out" | grep -c '^Summary: 0 passed')"
+    [ "$ignored" = "1 1" ] || break
+done
+check "test_runner (solution ignores stdin)" "1 1" "$ignored"
+
+rm -f solution test_runner
+
+echo -e "\nResults: $passed passed, $failed failed"
+[ $failed -eq 0 ]
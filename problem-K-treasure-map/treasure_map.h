@@ -0,0 +1,345 @@
+/*
+ * Problem K: Treasure Map
+ *
+ * solve() returns the minimum possible depth at the treasure given all
+ * readings, or TREASURE_IMPOSSIBLE if the readings contradict each other.
+ * OnlineTreasureMap answers the same question after every reading and at
+ * arbitrary grid points.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <limits>
+#include <numeric>
+#include <utility>
+#include <vector>
+#include "../common/fast_output.h"
+
+const long long TREASURE_IMPOSSIBLE = -1;
+
+// Reading: depth d at grid point (x, y), 1-based
+struct TreasureReading {
+    int x = 0, y = 0;
+    long long d = 0;
+};
+
+struct TreasureMapInput {
+    int n = 0, m = 0;          // grid rows and columns
+    int tx = 0, ty = 0;        // treasure, 1-based
+    std::vector<TreasureReading> readings;
+};
+
+// Batch solver: BFS over the row/column graph of the readings
+class TreasureMapWorkspace {
+public:
+    // Minimum treasure depth, or TREASURE_IMPOSSIBLE
+    long long solve(const TreasureMapInput& input) {
+        // Convert to 0-based indexing
+        int tx = input.tx - 1, ty = input.ty - 1;
+
+        const int ROWS = input.n;
+        const int COLS = input.m;
+        const int N = ROWS + COLS;
+
+        adj.resize(N);
+        for (int u = 0; u < N; u++) adj[u].clear();
+
+        auto rowNode = [&](int i) { return i; };
+        auto colNode = [&](int j) { return ROWS + j; };
+
+        bool impossible = false;
+
+        for (const TreasureReading& reading : input.readings) {
+            int x = reading.x - 1, y = reading.y - 1; // Convert to 0-based
+            long long d = reading.d;
+
+            if (x < 0 || x >= ROWS || y < 0 || y >= COLS) {
+                impossible = true;
+                continue;
+            }
+
+            if (d < 0) {
+                impossible = true;
+                continue;
+            }
+
+            int u = rowNode(x);
+            int v = colNode(y);
+            adj[u].push_back({v, d});
+            adj[v].push_back({u, d});
+        }
+
+        if (impossible) {
+            return TREASURE_IMPOSSIBLE;
+        }
+
+        // BFS to find connected components and assign values
+        val.assign(N, 0);
+        comp.assign(N, -1);
+        visited.assign(N, false);
+        comps.clear();
+
+        for (int start = 0; start < N && !impossible; start++) {
+            if (comp[start] != -1) continue;
+
+            int cid = comps.size();
+            comps.push_back(CompInfo{});
+
+            q.clear();
+            q.push_back(start);
+            comp[start] = cid;
+            visited[start] = true;
+            val[start] = 0;
+
+            while (!q.empty() && !impossible) {
+                int u = q.front();
+                q.pop_front();
+
+                if (u < ROWS) {
+                    comps[cid].hasRow = true;
+                    comps[cid].minRow = std::min(comps[cid].minRow, val[u]);
+                } else {
+                    comps[cid].hasCol = true;
+                    comps[cid].minCol = std::min(comps[cid].minCol, val[u]);
+                }
+
+                for (auto [v, z] : adj[u]) {
+                    if (!visited[v]) {
+                        visited[v] = true;
+                        comp[v] = cid;
+                        val[v] = z - val[u];
+                        q.push_back(v);
+                    } else {
+                        // Check consistency
+                        if (val[u] + val[v] != z) {
+                            impossible = true;
+                            break;
+                        }
+                    }
+                }
+            }
+
+            if (impossible) break;
+
+            // Check non-negativity constraint
+            if (comps[cid].hasRow && comps[cid].hasCol) {
+                if (comps[cid].minRow + comps[cid].minCol < 0) {
+                    impossible = true;
+                    break;
+                }
+            }
+        }
+
+        if (impossible) {
+            return TREASURE_IMPOSSIBLE;
+        }
+
+        // Calculate minimum depth at treasure location
+        // The treasure is at grid point (tx, ty)
+        // Depth = a_tx + b_ty = val[rowNode(tx)] + val[colNode(ty)] + u_comp(tx) - u_comp(ty)
+
+        int row_comp = comp[rowNode(tx)];
+        int col_comp = comp[colNode(ty)];
+
+        long long base_depth = val[rowNode(tx)] + val[colNode(ty)];
+
+        if (row_comp == col_comp) {
+            // Same component, u cancels out
+            return std::max(0LL, base_depth);
+        }
+
+        // Different components
+        long long min_depth = base_depth;
+
+        // We want to minimize: base_depth + u_row - u_col
+        // Subject to:
+        // - If comp[row] has rows: u_row >= -minRow[row_comp]
+        // - If comp[row] has cols: u_row <= minCol[row_comp]
+        // - If comp[col] has rows: u_col >= -minRow[col_comp]
+        // - If comp[col] has cols: u_col <= minCol[col_comp]
+
+        // To minimize, set u_row to minimum, u_col to maximum
+        if (comps[row_comp].hasRow) {
+            min_depth += (-comps[row_comp].minRow);
+        }
+        if (comps[col_comp].hasCol) {
+            min_depth -= comps[col_comp].minCol;
+        }
+
+        return std::max(0LL, min_depth);
+    }
+
+private:
+    struct CompInfo {
+        bool hasRow = false;
+        bool hasCol = false;
+        long long minRow = std::numeric_limits<long long>::max();
+        long long minCol = std::numeric_limits<long long>::max();
+    };
+
+    std::vector<std::vector<std::pair<int, long long>>> adj;
+    std::vector<long long> val;
+    std::vector<int> comp;
+    std::vector<bool> visited;
+    std::vector<CompInfo> comps;
+    std::deque<int> q;
+};
+
+inline long long solve(const TreasureMapInput& input, TreasureMapWorkspace& workspace) {
+    return workspace.solve(input);
+}
+
+inline long long solve(const TreasureMapInput& input) {
+    TreasureMapWorkspace workspace;
+    return solve(input, workspace);
+}
+
+// Incremental solver: weighted union-find over row and column nodes.
+//
+// With depth z(i,j) = a_i + b_j, write p = a_i for row nodes and p = -b_j for
+// column nodes; a reading a_x + b_y = d becomes p_row - p_col = d, a
+// difference constraint. Every component has one free shift U (p -> p + U),
+// so each node stores its potential relative to the parent and each root
+// keeps, relative to itself, the minimum row potential and maximum column
+// potential (minRow = minRowPot + U, minCol = -(maxColPot + U)).
+class OnlineTreasureMap {
+public:
+    OnlineTreasureMap(int rows, int cols, int tx, int ty)
+        : rows(rows), cols(cols), tx(tx), ty(ty), parent(rows + cols), size(rows + cols, 1),
+          pot(rows + cols, 0), minRowPot(rows + cols, INF), maxColPot(rows + cols, -INF) {
+        std::iota(parent.begin(), parent.end(), 0);
+        for (int i = 0; i < rows; i++) minRowPot[i] = 0;
+        for (int j = 0; j < cols; j++) maxColPot[rows + j] = 0;
+    }
+
+    // Add reading a_x + b_y = d (0-based); false once the map is inconsistent
+    bool add(int x, int y, long long d) {
+        if (impossible) return false;
+        if (x < 0 || x >= rows || y < 0 || y >= cols || d < 0) return fail();
+
+        int u = x, v = rows + y;
+        int ru = find(u), rv = find(v);
+        if (ru == rv) {
+            if (pot[u] - pot[v] != d) return fail();
+            return true;
+        }
+        // p_v = p_u - d, so root rv sits at pot[u] - d - pot[v] from ru
+        long long shift = pot[u] - d - pot[v];
+        if (size[ru] < size[rv]) {
+            std::swap(ru, rv);
+            shift = -shift;
+        }
+        parent[rv] = ru;
+        pot[rv] = shift;
+        size[ru] += size[rv];
+        if (minRowPot[rv] != INF) minRowPot[ru] = std::min(minRowPot[ru], minRowPot[rv] + shift);
+        if (maxColPot[rv] != -INF) maxColPot[ru] = std::max(maxColPot[ru], maxColPot[rv] + shift);
+
+        // Some depth in the merged component is minRow + minCol
+        if (minRowPot[ru] != INF && maxColPot[ru] != -INF && minRowPot[ru] < maxColPot[ru]) {
+            return fail();
+        }
+        return true;
+    }
+
+    bool consistent() const { return !impossible; }
+
+    // Minimum depth at the treasure given the readings so far
+    long long treasureDepth() { return depth(tx, ty); }
+
+    // Minimum depth at grid point (x, y), 0-based
+    long long depth(int x, int y) {
+        int r = x, c = rows + y;
+        find(r);
+        find(c);
+        return depthFlat(r, c);
+    }
+
+    // Point every node straight at its root, after the last reading. Then
+    // depthAt answers without touching the union-find.
+    void flatten() {
+        for (int x = 0; x < rows + cols; x++) find(x);
+    }
+
+    // O(1) depth at (x, y), 0-based; requires flatten()
+    long long depthAt(int x, int y) const { return depthFlat(x, rows + y); }
+
+    // Write the whole rows x cols min-depth grid, one row per line, holding
+    // a single row of depths at a time; requires flatten(). For row r with
+    // root R the depth at column c is
+    //     max(0, pot[r] - pot[c] + (root(c) == R ? 0 : maxColPot[root(c)] - minRowPot[R]))
+    // so per-column terms are prepared once and each row is a select + max.
+    void writeDepthMap(FastOutput& out) const {
+        typedef long long Lanes __attribute__((vector_size(16)));
+        size_t padded = (cols + 1) & ~size_t(1);
+        std::vector<long long> colRoot(padded), same(padded), other(padded), row(padded);
+        for (int j = 0; j < cols; j++) {
+            int c = rows + j;
+            colRoot[j] = parent[c];
+            same[j] = -pot[c];
+            other[j] = maxColPot[parent[c]] - pot[c];
+        }
+        for (int i = 0; i < rows; i++) {
+            long long root = parent[i];
+            Lanes rootV = {root, root};
+            Lanes baseV = {pot[i], pot[i]};
+            Lanes shiftV = {-minRowPot[root], -minRowPot[root]};
+            Lanes zero = {0, 0};
+            for (size_t j = 0; j < padded; j += 2) {
+                Lanes cr, sa, ot;
+                memcpy(&cr, &colRoot[j], sizeof(Lanes));
+                memcpy(&sa, &same[j], sizeof(Lanes));
+                memcpy(&ot, &other[j], sizeof(Lanes));
+                Lanes eq = cr == rootV;  // all ones where same component
+                Lanes v = baseV + ((eq & sa) | (~eq & (ot + shiftV)));
+                v &= v > zero;
+                memcpy(&row[j], &v, sizeof(Lanes));
+            }
+            for (int j = 0; j < cols; j++) {
+                if (j) out << ' ';
+                out << (unsigned long long)row[j];
+            }
+            out << '\n';
+        }
+    }
+
+private:
+    static constexpr long long INF = std::numeric_limits<long long>::max() / 4;
+
+    bool fail() {
+        impossible = true;
+        return false;
+    }
+
+    // Depth for row node r and column node c whose parents are their roots
+    long long depthFlat(int r, int c) const {
+        int rr = parent[r], rc = parent[c];
+        if (rr == rc) return std::max(0LL, pot[r] - pot[c]);
+        // Lowest row shift for r's component, highest column shift for c's
+        long long d = (pot[r] - minRowPot[rr]) + (maxColPot[rc] - pot[c]);
+        return std::max(0LL, d);
+    }
+
+    // Root of x; afterwards pot[x] is relative to the root
+    int find(int x) {
+        int root = x;
+        while (parent[root] != root) root = parent[root];
+        // Second pass: accumulate potentials from the top of the path down
+        path.clear();
+        for (int y = x; y != root; y = parent[y]) path.push_back(y);
+        for (int i = (int)path.size() - 2; i >= 0; i--) {
+            pot[path[i]] += pot[path[i + 1]];
+            parent[path[i]] = root;
+        }
+        return root;
+    }
+
+    int rows, cols, tx, ty;
+    std::vector<int> parent, size;
+    std::vector<long long> pot, minRowPot, maxColPot;
+    std::vector<int> path;
+    bool impossible = false;
+};
@@ -2,7 +2,7 @@
 
 # Compile the solution
 echo "Compiling solution..."
-g++ -O2 -std=c++17 -o solution solution.cpp
+g++ -O2 -std=c++17 -pthread -o solution solution.cpp
 
 if [ $? -ne 0 ]; then
     echo "Compilation failed!"
@@ -29,7 +29,41 @@ for i in {1..6}; do
     else
         echo " ✗ (expected: ${expected[$i-1]})"
     fi
+
+    # High-throughput path, from a file (mapped) and from a pipe
+    for src in file pipe; do
+        if [ $src = file ]; then
+            output=$(./solution --fast=2 < test_inputs/test$i.txt)
+        else
+            output=$(cat test_inputs/test$i.txt | ./solution --fast=2)
+        fi
+        if [ "$output" = "${expected[$i-1]}" ]; then
+            echo "Test $i (--fast, $src): $output ✓"
+        else
+            echo "Test $i (--fast, $src): $output ✗ (expected: ${expected[$i-1]})"
+        fi
+    done
+
+    # Query mode: the header pair is the first query; ask it twice
+    output=$( (cat test_inputs/test$i.txt; echo; head -n 1 test_inputs/test$i.txt | cut -d' ' -f2-) \
+        | ./solution --queries=2 | sort -u)
+    if [ "$output" = "${expected[$i-1]}" ]; then
+        echo "Test $i (--queries): $output ✓"
+    else
+        echo "Test $i (--queries): $output ✗ (expected: ${expected[$i-1]})"
+    fi
+
+    # The same layout queried through the dynamic engine
+    read -r n xs ys xt yt < test_inputs/test$i.txt
+    output=$( (cat test_inputs/test$i.txt; echo; echo "? $ys $yt") | ./solution --dynamic)
+    if [ "$output" = "${expected[$i-1]}" ]; then
+        echo "Test $i (--dynamic): $output ✓"
+    else
+        echo "Test $i (--dynamic): $output ✗ (expected: ${expected[$i-1]})"
+    fi
 done
 
+rm -f solution
+
 echo "==================="
 echo "All tests complete!"
\ No newline at end of file
@@ -1,82 +1,401 @@
 #include <bits/stdc++.h>
+#include "../common/fast_input.h"
+#include "../common/fast_output.h"
+#include "walking_sunshine.h"
 using namespace std;
 
-int main() {
-    ios::sync_with_stdio(false);
-    cin.tie(nullptr);
-    
-    int N;
-    if (!(cin >> N)) return 0;
-    double xs, ys, xt, yt;
-    cin >> xs >> ys >> xt >> yt;
-    
+// Usage: ./solution [--dynamic | --queries[=THREADS] | --fast[=THREADS]] < input.txt
+//   --dynamic  after the rectangles, read operations until EOF:
+//                + x1 y1 x2 y2   add a rectangle (ids continue after the N
+//                                initial ones, which are 1..N)
+//                - id            remove rectangle id
+//                ? ys yt         print the uncovered southward drop from ys
+//                                to yt under the current rectangles
+//              each in O(log N) over the compressed y coordinates
+//   --queries  after the rectangles, read more "xs ys xt yt" lines until EOF
+//              and print the sunny distance of every pair (the first line's
+//              included), in input order; the
+//              rectangles are merged once and every query is two binary
+//              searches, spread over THREADS threads
+//   --fast     same answer as the default, for 10^7+ rectangles: stdin is
+//              mapped and parsed with from_chars in parallel slices, the
+//              clipped intervals are radix sorted on order-preserving uint64
+//              keys, and sorted chunks are merged in parallel and stitched
+
+void printAnswer(FastOutput& out, double ans) {
+    out << Fixed{ans, 10} << '\n';
+}
+
+// Shaded layout under insertions and removals; all operations are read first
+// so that the y coordinates can be compressed once
+int runDynamic(FastInput& in, FastOutput& out, int N) {
+    struct Rect {
+        double lo, hi;
+        bool active;
+    };
+    struct Op {
+        char type;
+        int id;          // '-' target, '+' new id
+        double a, b;     // '?' ys, yt
+    };
+
+    vector<Rect> rects;
+    vector<double> coords;
+    rects.reserve(N);
+    auto readRect = [&]() {
+        double x1, y1, x2, y2;
+        in >> x1 >> y1 >> x2 >> y2;
+        double lo = min(y1, y2), hi = max(y1, y2);
+        rects.push_back({lo, hi, false});
+        coords.push_back(lo);
+        coords.push_back(hi);
+    };
+    for (int i = 0; i < N; ++i) readRect();
+
+    vector<Op> ops;
+    char type;
+    while (in >> type) {
+        Op op{type, 0, 0, 0};
+        if (type == '+') {
+            readRect();
+            op.id = rects.size();
+        } else if (type == '-') {
+            in >> op.id;
+        } else if (type == '?') {
+            in >> op.a >> op.b;
+            coords.push_back(op.a);
+            coords.push_back(op.b);
+        } else {
+            cerr << "Unknown operation: " << type << "\n";
+            return 1;
+        }
+        if (!in) {
+            cerr << "Error: truncated operation " << (ops.size() + 1) << "\n";
+            return 1;
+        }
+        ops.push_back(op);
+    }
+
+    CoverageTree tree(coords);
+    auto activate = [&](int id) {
+        Rect& r = rects[id - 1];
+        r.active = true;
+        tree.insert(r.lo, r.hi);
+    };
+    for (int id = 1; id <= N; ++id) activate(id);
+
+    for (const Op& op : ops) {
+        if (op.type == '+') {
+            activate(op.id);
+        } else if (op.type == '-') {
+            // Unknown or already removed ids are ignored
+            if (op.id < 1 || op.id > (int)rects.size() || !rects[op.id - 1].active) continue;
+            Rect& r = rects[op.id - 1];
+            r.active = false;
+            tree.remove(r.lo, r.hi);
+        } else {
+            // Southward drop only; northward movement is free
+            printAnswer(out, op.a > op.b ? tree.uncovered(op.b, op.a) : 0.0);
+        }
+    }
+    return 0;
+}
+
+// One layout, many (xs, ys, xt, yt) queries answered in input order
+// (the pair on the first line is query 1)
+int runQueries(FastInput& in, FastOutput& out, int N, int threads, double ys0, double yt0) {
     vector<pair<double,double>> intervals;
     intervals.reserve(N);
+    for (int i = 0; i < N; ++i) {
+        double x1, y1, x2, y2;
+        in >> x1 >> y1 >> x2 >> y2;
+        intervals.emplace_back(min(y1, y2), max(y1, y2));
+    }
+    ShadeIndex index(move(intervals));
+
+    vector<pair<double,double>> queries{{ys0, yt0}};   // (ys, yt)
+    double xs, ys, xt, yt;
+    while (in >> xs >> ys >> xt >> yt) queries.emplace_back(ys, yt);
 
-    double Ymin = min(ys, yt);
-    double Ymax = max(ys, yt);
+    // Contiguous slices, each formatted by its own thread, written in order
+    threads = max(1, min<int>(threads, queries.size() / 4096 + 1));
+    vector<string> text(threads);
+    auto worker = [&](int t) {
+        size_t begin = queries.size() * t / threads, end = queries.size() * (t + 1) / threads;
+        string& slice = text[t];
+        slice.reserve((end - begin) * 20);
+        char buf[400];
+        for (size_t i = begin; i < end; ++i) {
+            char* p = formatFixed(buf, index.drop(queries[i].first, queries[i].second), 10);
+            *p++ = '\n';
+            slice.append(buf, p);
+        }
+    };
+    vector<thread> pool;
+    for (int t = 1; t < threads; t++) pool.emplace_back(worker, t);
+    worker(0);
+    for (auto& th : pool) th.join();
+    for (const string& slice : text) out << slice;
+    return 0;
+}
 
-    // If no southward movement required
-    if (ys <= yt) {
-        cout.setf(std::ios::fixed); 
-        cout << setprecision(10) << 0.0 << "\n";
-        // Still need to consume rectangle input
-        for (int i = 0; i < N; ++i) {
-            double x1, y1, x2, y2;
-            cin >> x1 >> y1 >> x2 >> y2;
+// ---- High-throughput path (--fast) ----
+
+// Doubles as unsigned keys with the same order (negatives flipped entirely,
+// non-negatives get the sign bit set)
+inline uint64_t orderedKey(double d) {
+    uint64_t bits;
+    memcpy(&bits, &d, sizeof(bits));
+    return (bits >> 63) ? ~bits : bits | (1ULL << 63);
+}
+
+struct KeyedInterval {
+    uint64_t key;   // orderedKey(lo)
+    double lo, hi;
+};
+
+// Run fn(t) for t in [0, threads) on threads - 1 helpers plus the caller
+template <class Fn>
+void parallelFor(int threads, Fn fn) {
+    vector<thread> pool;
+    for (int t = 1; t < threads; t++) pool.emplace_back(fn, t);
+    fn(0);
+    for (auto& th : pool) th.join();
+}
+
+// Stable LSD radix sort by key, 16 bits per pass; each thread histograms and
+// scatters its own slice. Passes whose digit is the same everywhere are skipped.
+void radixSort(vector<KeyedInterval>& a, int threads) {
+    const int BITS = 16, BUCKETS = 1 << BITS;
+    size_t n = a.size();
+    vector<KeyedInterval> tmp(n);
+    vector<vector<size_t>> count(threads, vector<size_t>(BUCKETS));
+    auto slice = [&](int t) { return make_pair(n * t / threads, n * (t + 1) / threads); };
+
+    for (int shift = 0; shift < 64; shift += BITS) {
+        parallelFor(threads, [&](int t) {
+            auto [b, e] = slice(t);
+            vector<size_t>& c = count[t];
+            fill(c.begin(), c.end(), 0);
+            for (size_t i = b; i < e; i++) c[(a[i].key >> shift) & (BUCKETS - 1)]++;
+        });
+        uint64_t digit0 = (a[0].key >> shift) & (BUCKETS - 1);
+        size_t same = 0;
+        for (int t = 0; t < threads; t++) same += count[t][digit0];
+        if (same == n) continue;
+
+        // Bucket-major, thread-minor offsets keep the sort stable
+        size_t offset = 0;
+        for (int d = 0; d < BUCKETS; d++) {
+            for (int t = 0; t < threads; t++) {
+                size_t c = count[t][d];
+                count[t][d] = offset;
+                offset += c;
+            }
         }
+        parallelFor(threads, [&](int t) {
+            auto [b, e] = slice(t);
+            vector<size_t>& pos = count[t];
+            for (size_t i = b; i < e; i++) tmp[pos[(a[i].key >> shift) & (BUCKETS - 1)]++] = a[i];
+        });
+        a.swap(tmp);
+    }
+}
+
+// Merged intervals of one sorted chunk
+struct ChunkUnion {
+    vector<pair<double,double>> merged;
+    vector<double> prefix;   // prefix[k] = length of merged[0..k)
+};
+
+int runFast(FastInput& in, FastOutput& out, int threads) {
+    string_view input = in.rest();
+    const char* p = input.data();
+    const char* end = p + input.size();
+
+    double header[5];
+    for (double& v : header) {
+        if (!parseDouble(p, end, v)) return 0;
+    }
+    long long N = (long long)header[0];
+    double ys = header[2], yt = header[4];
+    if (ys <= yt) {
+        printAnswer(out, 0.0);
         return 0;
     }
+    double Ymin = yt, Ymax = ys;
 
-    const double EPS = 1e-12;
+    // Parse: rectangles are normally one per line, so split the rest at
+    // newlines and let every thread clip its own lines. A slice that finds a
+    // line without exactly four numbers gives up, and the whole input is then
+    // parsed as one slice, token by token, like a single thread does.
+    threads = max(1, (int)min<long long>(threads, N / 65536 + 1));
+    vector<const char*> cuts{p};
+    for (int t = 1; t < threads; t++) {
+        const char* c = p + (end - p) * t / threads;
+        c = max(c, cuts.back());
+        while (c < end && *c != '\n') ++c;
+        cuts.push_back(c);
+    }
+    cuts.push_back(end);
 
-    for (int i = 0; i < N; ++i) {
-        double x1, y1, x2, y2;
-        cin >> x1 >> y1 >> x2 >> y2;
-        double ylo = min(y1, y2);
-        double yhi = max(y1, y2);
-        // Clip to [Ymin, Ymax]
-        double l = max(ylo, Ymin);
-        double r = min(yhi, Ymax);
-        if (r > l + EPS) {
-            intervals.emplace_back(l, r);
+    // Clip the rectangles in [q, e); false if byLine and a line is irregular
+    auto parseSlice = [&](const char* q, const char* e, bool byLine,
+                          vector<KeyedInterval>& out, long long& seen) {
+        auto lineRest = [&]() {   // skip blanks, stopping at a newline
+            while (q < e && *q != '\n' && isInputSpace(*q)) ++q;
+        };
+        out.reserve((e - q) / 24);
+        double r[4];
+        while (true) {
+            int got = 0;
+            while (got < 4) {
+                if (got > 0 && byLine) {
+                    lineRest();
+                    if (q < e && *q == '\n') return false;
+                }
+                if (!parseDouble(q, e, r[got])) break;
+                got++;
+            }
+            if (got < 4) {
+                if (!byLine) break;
+                while (q < e && isInputSpace(*q)) ++q;
+                return got == 0 && q == e;
+            }
+            if (byLine) {
+                lineRest();
+                if (q < e && *q != '\n') return false;
+            }
+            seen++;
+            double l = max(min(r[1], r[3]), Ymin);
+            double h = min(max(r[1], r[3]), Ymax);
+            if (h > l + SUNSHINE_EPS) out.push_back({orderedKey(l), l, h});
         }
+        return true;
+    };
+
+    vector<vector<KeyedInterval>> parsed(threads);
+    vector<long long> rectsSeen(threads, 0);
+    vector<char> regular(threads, 1);
+    parallelFor(threads, [&](int t) {
+        regular[t] = parseSlice(cuts[t], cuts[t + 1], threads > 1, parsed[t], rectsSeen[t]);
+    });
+    if (count(regular.begin(), regular.end(), 0) > 0) {
+        parsed.assign(1, {});
+        rectsSeen.assign(1, 0);
+        parseSlice(p, end, false, parsed[0], rectsSeen[0]);
+    }
+    if (accumulate(rectsSeen.begin(), rectsSeen.end(), 0LL) < N) {
+        cerr << "Error: expected " << N << " rectangles\n";
+        return 1;
     }
 
-    if (intervals.empty()) {
-        double ans = Ymax - Ymin;
-        cout.setf(std::ios::fixed);
-        cout << setprecision(10) << ans << "\n";
+    size_t total = 0;
+    for (auto& v : parsed) total += v.size();
+    if (total == 0) {
+        printAnswer(out, Ymax - Ymin);
         return 0;
     }
+    vector<KeyedInterval> all;
+    if (threads == 1) {
+        all.swap(parsed[0]);
+    } else {
+        all.reserve(total);
+        for (auto& v : parsed) {
+            all.insert(all.end(), v.begin(), v.end());
+            vector<KeyedInterval>().swap(v);
+        }
+    }
 
-    sort(intervals.begin(), intervals.end(), [&](const auto& a, const auto& b){
-        if (a.first < b.first - EPS) return true;
-        if (a.first > b.first + EPS) return false;
-        return a.second < b.second;
+    // Small inputs: a comparison sort beats the 64K-bucket histograms
+    if (all.size() < (1u << 16)) {
+        sort(all.begin(), all.end(), [](const auto& a, const auto& b) { return a.key < b.key; });
+    } else {
+        radixSort(all, threads);
+    }
+
+    // Merge sorted chunks independently...
+    vector<ChunkUnion> chunks(threads);
+    parallelFor(threads, [&](int t) {
+        size_t b = all.size() * t / threads, e = all.size() * (t + 1) / threads;
+        ChunkUnion& cu = chunks[t];
+        for (size_t i = b; i < e; i++) {
+            if (!cu.merged.empty() && all[i].lo <= cu.merged.back().second + SUNSHINE_EPS) {
+                cu.merged.back().second = max(cu.merged.back().second, all[i].hi);
+            } else {
+                cu.merged.push_back({all[i].lo, all[i].hi});
+            }
+        }
+        cu.prefix.resize(cu.merged.size() + 1, 0.0);
+        for (size_t j = 0; j < cu.merged.size(); j++) {
+            cu.prefix[j + 1] = cu.prefix[j] + (cu.merged[j].second - cu.merged[j].first);
+        }
     });
 
+    // ...then stitch: only a chunk's leading intervals can touch the interval
+    // still open from earlier chunks, since everything after starts later
     double covered = 0.0;
-    double curL = intervals[0].first;
-    double curR = intervals[0].second;
-
-    for (size_t i = 1; i < intervals.size(); ++i) {
-        double l = intervals[i].first;
-        double r = intervals[i].second;
-        if (l <= curR + EPS) {
-            if (r > curR) curR = r;
-        } else {
-            covered += max(0.0, curR - curL);
-            curL = l; curR = r;
+    double curL = 0.0, curR = 0.0;
+    bool open = false;
+    for (const ChunkUnion& cu : chunks) {
+        size_t j = 0, m = cu.merged.size();
+        if (open) {
+            while (j < m && cu.merged[j].first <= curR + SUNSHINE_EPS) {
+                curR = max(curR, cu.merged[j].second);
+                j++;
+            }
+        }
+        if (j == m) continue;
+        if (open) covered += curR - curL;
+        covered += cu.prefix[m - 1] - cu.prefix[j];   // merged[j..m-1) are final
+        tie(curL, curR) = cu.merged[m - 1];
+        open = true;
+    }
+    if (open) covered += curR - curL;
+
+    double ans = (Ymax - Ymin) - covered;
+    printAnswer(out, max(0.0, ans));
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    bool dynamic = false;
+    int queryThreads = 0;
+    int fastThreads = 0;
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (arg == "--dynamic") dynamic = true;
+        else if (arg == "--queries") queryThreads = max(1u, thread::hardware_concurrency());
+        else if (arg.rfind("--queries=", 0) == 0) queryThreads = max(1, atoi(arg.c_str() + 10));
+        else if (arg == "--fast") fastThreads = max(1u, thread::hardware_concurrency());
+        else if (arg.rfind("--fast=", 0) == 0) fastThreads = max(1, atoi(arg.c_str() + 7));
+        else {
+            cerr << "Usage: " << argv[0] << " [--dynamic | --queries[=THREADS] | --fast[=THREADS]]"
+                 << " < input.txt\n";
+            return 1;
         }
     }
-    covered += max(0.0, curR - curL);
+    
+    FastInput in;
+    FastOutput out;
+    if (fastThreads > 0) return runFast(in, out, fastThreads);
 
-    double totalDrop = Ymax - Ymin;
-    double ans = totalDrop - covered;
-    if (ans < 0) ans = 0; // clamp due to numeric tolerance
+    int N;
+    if (!(in >> N)) return 0;
+    double xs, ys, xt, yt;
+    in >> xs >> ys >> xt >> yt;
 
-    cout.setf(std::ios::fixed);
-    cout << setprecision(10) << ans << "\n";
+    if (dynamic) return runDynamic(in, out, N);
+    if (queryThreads > 0) return runQueries(in, out, N, queryThreads, ys, yt);
+    
+    // Rectangles go straight into the workspace, never stored whole
+    SunshineWorkspace workspace;
+    workspace.start(ys, yt, N);
+    for (int i = 0; i < N; ++i) {
+        Rectangle rect;
+        in >> rect.x1 >> rect.y1 >> rect.x2 >> rect.y2;
+        workspace.add(rect);
+    }
+    printAnswer(out, workspace.finish());
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,212 @@
+/*
+ * Problem L: Walking on Sunshine
+ *
+ * solve() returns the length of the southward part of the walk that cannot
+ * be spent in shade. The workspace's start/add/finish take the rectangles
+ * one at a time without storing them. ShadeIndex answers many start/end
+ * pairs against one set of rectangles, and CoverageTree keeps the answer
+ * current while rectangles come and go.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+// Covered length of the y axis under a changing multiset of intervals.
+//
+// The y coordinates of every interval and query are known up front and
+// compressed once; each leaf is one elementary gap [ys[i], ys[i+1]]. A node
+// holds how many intervals cover its whole range (never pushed down) and the
+// covered length inside it, so insert and remove touch O(log N) nodes and the
+// root stays consistent without any re-sort.
+class CoverageTree {
+public:
+    explicit CoverageTree(std::vector<double> coords) : ys(std::move(coords)) {
+        std::sort(ys.begin(), ys.end());
+        ys.erase(std::unique(ys.begin(), ys.end()), ys.end());
+        leaves = std::max<int>(1, (int)ys.size() - 1);
+        cover.assign(4 * leaves, 0);
+        covered.assign(4 * leaves, 0.0);
+    }
+
+    void insert(double lo, double hi) { update(lo, hi, +1); }
+    void remove(double lo, double hi) { update(lo, hi, -1); }
+
+    // Length of [lo, hi] not covered by any interval (lo, hi must be coordinates)
+    double uncovered(double lo, double hi) const {
+        if (hi <= lo) return 0.0;
+        int l = index(lo), r = index(hi);
+        return (hi - lo) - coveredIn(1, 0, leaves, l, r);
+    }
+
+private:
+    int index(double y) const { return std::lower_bound(ys.begin(), ys.end(), y) - ys.begin(); }
+
+    void update(double lo, double hi, int delta) {
+        if (hi <= lo || ys.size() < 2) return;
+        update(1, 0, leaves, index(lo), index(hi), delta);
+    }
+
+    // Node covers elementary gaps [nl, nr), i.e. y range [ys[nl], ys[nr]]
+    void update(int node, int nl, int nr, int l, int r, int delta) {
+        if (r <= nl || nr <= l) return;
+        if (l <= nl && nr <= r) {
+            cover[node] += delta;
+        } else {
+            int mid = (nl + nr) / 2;
+            update(2 * node, nl, mid, l, r, delta);
+            update(2 * node + 1, mid, nr, l, r, delta);
+        }
+        pull(node, nl, nr);
+    }
+
+    void pull(int node, int nl, int nr) {
+        if (cover[node] > 0) covered[node] = ys[nr] - ys[nl];
+        else if (nr - nl == 1) covered[node] = 0.0;
+        else covered[node] = covered[2 * node] + covered[2 * node + 1];
+    }
+
+    double coveredIn(int node, int nl, int nr, int l, int r) const {
+        if (r <= nl || nr <= l) return 0.0;
+        if (cover[node] > 0) return ys[std::min(nr, r)] - ys[std::max(nl, l)];
+        if (l <= nl && nr <= r) return covered[node];
+        int mid = (nl + nr) / 2;
+        return coveredIn(2 * node, nl, mid, l, r) + coveredIn(2 * node + 1, mid, nr, l, r);
+    }
+
+    std::vector<double> ys;
+    int leaves;
+    std::vector<int> cover;       // intervals covering the whole node range
+    std::vector<double> covered;  // covered length within the node range
+};
+
+const double SUNSHINE_EPS = 1e-12;
+
+// Sort intervals and merge overlapping (or SUNSHINE_EPS-touching) ones in place;
+// the result is disjoint and ordered
+inline void mergeIntervals(std::vector<std::pair<double,double>>& intervals) {
+    if (intervals.empty()) return;
+    std::sort(intervals.begin(), intervals.end(), [&](const auto& a, const auto& b){
+        if (a.first < b.first - SUNSHINE_EPS) return true;
+        if (a.first > b.first + SUNSHINE_EPS) return false;
+        return a.second < b.second;
+    });
+
+    size_t out = 0;
+    for (size_t i = 1; i < intervals.size(); ++i) {
+        double l = intervals[i].first;
+        double r = intervals[i].second;
+        if (l <= intervals[out].second + SUNSHINE_EPS) {
+            if (r > intervals[out].second) intervals[out].second = r;
+        } else {
+            intervals[++out] = {l, r};
+        }
+    }
+    intervals.resize(out + 1);
+}
+
+// Disjoint union of all shade intervals with prefix sums of covered length;
+// the covered length of any [lo, hi] is two binary searches
+class ShadeIndex {
+public:
+    explicit ShadeIndex(std::vector<std::pair<double,double>> intervals) : merged(std::move(intervals)) {
+        mergeIntervals(merged);
+        prefix.resize(merged.size() + 1, 0.0);
+        for (size_t i = 0; i < merged.size(); ++i) {
+            prefix[i + 1] = prefix[i] + std::max(0.0, merged[i].second - merged[i].first);
+        }
+    }
+
+    // Covered length on (-inf, y]
+    double coveredBelow(double y) const {
+        size_t i = std::upper_bound(merged.begin(), merged.end(), y,
+                               [](double v, const auto& iv) { return v < iv.first; }) - merged.begin();
+        if (i == 0) return 0.0;
+        const auto& last = merged[i - 1];
+        return prefix[i - 1] + std::max(0.0, std::min(y, last.second) - last.first);
+    }
+
+    // Sunny part of the southward drop from ys to yt
+    double drop(double ys, double yt) const {
+        if (ys <= yt) return 0.0;
+        return std::max(0.0, (ys - yt) - (coveredBelow(ys) - coveredBelow(yt)));
+    }
+
+private:
+    std::vector<std::pair<double,double>> merged;
+    std::vector<double> prefix;   // prefix[i] = covered length of merged[0..i)
+};
+
+// Axis-parallel shade rectangle, corners in any order
+struct Rectangle {
+    double x1 = 0, y1 = 0, x2 = 0, y2 = 0;
+};
+
+struct SunshineInput {
+    double xs = 0, ys = 0, xt = 0, yt = 0;   // start and destination
+    std::vector<Rectangle> rectangles;
+};
+
+class SunshineWorkspace {
+public:
+    // Sunny distance of the walk from (xs, ys) to (xt, yt)
+    double solve(const SunshineInput& input) {
+        start(input.ys, input.yt, input.rectangles.size());
+        for (const Rectangle& rect : input.rectangles) add(rect);
+        return finish();
+    }
+
+    // The same in three steps, for callers that stream the rectangles
+    // instead of holding them: start(), add() each one, then finish()
+    void start(double ys, double yt, size_t expected = 0) {
+        Ymin = std::min(ys, yt);
+        Ymax = std::max(ys, yt);
+        southward = ys > yt;
+        intervals.clear();
+        intervals.reserve(expected);
+    }
+
+    void add(const Rectangle& rect) {
+        // If no southward movement required, nothing can shade it
+        if (!southward) return;
+        double ylo = std::min(rect.y1, rect.y2);
+        double yhi = std::max(rect.y1, rect.y2);
+        // Clip to [Ymin, Ymax]
+        double l = std::max(ylo, Ymin);
+        double r = std::min(yhi, Ymax);
+        if (r > l + SUNSHINE_EPS) {
+            intervals.emplace_back(l, r);
+        }
+    }
+
+    double finish() {
+        if (!southward) return 0.0;
+        if (intervals.empty()) return Ymax - Ymin;
+
+        mergeIntervals(intervals);
+        double covered = 0.0;
+        for (const auto& [l, r] : intervals) covered += std::max(0.0, r - l);
+
+        double totalDrop = Ymax - Ymin;
+        double ans = totalDrop - covered;
+        if (ans < 0) ans = 0; // clamp due to numeric tolerance
+        return ans;
+    }
+
+private:
+    double Ymin = 0, Ymax = 0;
+    bool southward = false;
+    std::vector<std::pair<double,double>> intervals;   // clipped shade intervals
+};
+
+inline double solve(const SunshineInput& input, SunshineWorkspace& workspace) {
+    return workspace.solve(input);
+}
+
+inline double solve(const SunshineInput& input) {
+    SunshineWorkspace workspace;
+    return solve(input, workspace);
+}